@@ -0,0 +1,214 @@
+#include "AssetPack.h"
+#include "BC7.h"
+
+#include <iostream>
+#include <cstring>
+
+static const char PACK_MAGIC[8] = {'F', 'C', 'P', 'A', 'C', 'K', 0, 0};
+static const uint32_t PACK_VERSION = 2;
+static const uint64_t PACK_ALIGNMENT = 64;
+
+static uint64_t alignUp(uint64_t value)
+{
+    return (value + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+}
+
+string normalizeAssetPath(const string& path)
+{
+    string normalized = path;
+    for (char& c : normalized) {
+        if (c == '\\') c = '/';
+    }
+
+    while (true) {
+        if (normalized.compare(0, 3, "../") == 0) {
+            normalized.erase(0, 3);
+        } else if (normalized.compare(0, 2, "./") == 0) {
+            normalized.erase(0, 2);
+        } else {
+            break;
+        }
+    }
+    return normalized;
+}
+
+bool packTextureSize(uint32_t format, uint32_t width, uint32_t height, uint32_t levels, uint64_t& outBytes)
+{
+    // Bem acima de qualquer textura suportada; mantém as contas sem estouro
+    const uint32_t MAX_DIMENSION = 65536;
+    if (format != PACK_FORMAT_RGBA8 && format != PACK_FORMAT_BC7) return false;
+    if (width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION) return false;
+
+    uint32_t maxLevels = 1;
+    for (uint32_t size = width > height ? width : height; size > 1; size /= 2) maxLevels++;
+    if (levels == 0 || levels > maxLevels) return false;
+
+    uint64_t total = 0;
+    for (uint32_t level = 0; level < levels; level++) {
+        total += format == PACK_FORMAT_BC7 ? (uint64_t)bc7ImageSize((int)width, (int)height)
+                                           : (uint64_t)width * height * 4;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    outBytes = total;
+    return true;
+}
+
+// ===== LEITURA =====
+
+// Confere uma entrada contra o arquivo e o próprio tipo: quem usa o pacote
+// lê direto do mapeamento, confiando nestes campos
+static bool validEntry(const PackEntry& entry, uint64_t size)
+{
+    // Comparações pelo espaço que sobra, para um cabeçalho corrompido não dar a volta
+    if (entry.dataOffset > size || entry.dataSize > size - entry.dataOffset) return false;
+
+    if (entry.type == PACK_TEXTURE) {
+        uint64_t expected = 0;
+        return packTextureSize(entry.format, entry.width, entry.height, entry.mipLevels, expected) &&
+               entry.dataSize >= expected;
+    }
+    if (entry.type == PACK_AUDIO_PCM) {
+        return entry.channels > 0 && entry.sampleRate > 0 &&
+               entry.dataOffset % sizeof(float) == 0 &&
+               entry.frameCount <= entry.dataSize / ((uint64_t)entry.channels * sizeof(float));
+    }
+    return entry.type == PACK_AUDIO_ENCODED;
+}
+
+AssetPack::AssetPack() : entries(nullptr), entryCount(0), strings(nullptr), contentHash(0)
+{
+}
+
+bool AssetPack::open(const string& filePath)
+{
+    close();
+    if (!file.open(filePath)) return false;
+
+    const unsigned char* bytes = file.data();
+    size_t size = file.size();
+
+    PackHeader header;
+    if (size < sizeof(header)) {
+        close();
+        return false;
+    }
+    memcpy(&header, bytes, sizeof(header));
+
+    uint64_t tocEnd = sizeof(header) + (uint64_t)header.entryCount * sizeof(PackEntry);
+    bool valid = memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0 &&
+                 header.version == PACK_VERSION &&
+                 tocEnd <= size &&
+                 header.stringTableOffset >= tocEnd &&
+                 header.stringTableOffset <= size &&
+                 header.stringTableSize <= size - header.stringTableOffset &&
+                 (header.stringTableSize == 0 || bytes[header.stringTableOffset + header.stringTableSize - 1] == '\0');
+    if (!valid) {
+        cerr << "Pacote de assets inválido ou de outra versão: " << filePath << endl;
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const PackEntry*>(bytes + sizeof(header));
+    entryCount = header.entryCount;
+    strings = reinterpret_cast<const char*>(bytes + header.stringTableOffset);
+    contentHash = header.contentHash;
+
+    for (size_t i = 0; i < entryCount; i++) {
+        const PackEntry& entry = entries[i];
+        // A tabela termina em '\0', então todo nome dentro dela também termina
+        if (entry.nameOffset >= header.stringTableSize || !validEntry(entry, size)) {
+            cerr << "Pacote de assets corrompido: " << filePath << " (entrada " << i << ")" << endl;
+            close();
+            return false;
+        }
+        index[strings + entry.nameOffset] = i;
+    }
+
+    cout << "Pacote de assets: " << filePath << " (" << entryCount << " entradas, "
+         << size / 1024 << " KB mapeados)" << endl;
+    return true;
+}
+
+void AssetPack::close()
+{
+    file.close();
+    entries = nullptr;
+    entryCount = 0;
+    strings = nullptr;
+    contentHash = 0;
+    index.clear();
+}
+
+const PackEntry* AssetPack::find(const string& assetPath) const
+{
+    if (!isOpen()) return nullptr;
+
+    auto it = index.find(normalizeAssetPath(assetPath));
+    return it != index.end() ? &entries[it->second] : nullptr;
+}
+
+string AssetPack::entryName(const PackEntry& entry) const
+{
+    return strings != nullptr ? string(strings + entry.nameOffset) : string();
+}
+
+// ===== ESCRITA =====
+
+void AssetPackWriter::add(const string& assetPath, const PackEntry& entry, const void* data, size_t size)
+{
+    string name = normalizeAssetPath(assetPath);
+
+    // Mesmo asset referenciado por mais de uma chave: guarda uma vez só
+    for (const string& existing : names) {
+        if (existing == name) return;
+    }
+
+    entries.push_back(entry);
+    names.push_back(name);
+    blobs.emplace_back((const unsigned char*)data, (const unsigned char*)data + size);
+}
+
+bool AssetPackWriter::write(const string& filePath)
+{
+    PackHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.entryCount = (uint32_t)entries.size();
+
+    // Tabela de strings logo após o índice
+    string stringTable;
+    for (size_t i = 0; i < entries.size(); i++) {
+        entries[i].nameOffset = (uint32_t)stringTable.size();
+        stringTable += names[i];
+        stringTable.push_back('\0');
+    }
+    header.stringTableOffset = sizeof(header) + entries.size() * sizeof(PackEntry);
+    header.stringTableSize = stringTable.size();
+
+    // Dados alinhados, para poderem ser usados direto do mapeamento
+    uint64_t offset = alignUp(header.stringTableOffset + header.stringTableSize);
+    uint64_t contentHash = hashBytes(stringTable.data(), stringTable.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        entries[i].dataOffset = offset;
+        entries[i].dataSize = blobs[i].size();
+        offset = alignUp(offset + blobs[i].size());
+        contentHash = hashBytes(blobs[i].data(), blobs[i].size(), contentHash);
+    }
+    header.contentHash = contentHash;
+
+    vector<unsigned char> fileData(offset, 0);
+    memcpy(fileData.data(), &header, sizeof(header));
+    if (!entries.empty()) {
+        memcpy(fileData.data() + sizeof(header), entries.data(), entries.size() * sizeof(PackEntry));
+    }
+    memcpy(fileData.data() + header.stringTableOffset, stringTable.data(), stringTable.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (!blobs[i].empty()) {
+            memcpy(fileData.data() + entries[i].dataOffset, blobs[i].data(), blobs[i].size());
+        }
+    }
+
+    return writeFileAtomic(filePath, fileData.data(), fileData.size());
+}
@@ -0,0 +1,140 @@
+#include "AudioCache.h"
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+
+static const char PCM_CACHE_MAGIC[8] = {'F', 'C', 'P', 'C', 'M', 0, 0, 0};
+static const uint32_t PCM_CACHE_VERSION = 1;
+static const uint32_t PCM_CACHE_ALIGNMENT = 64;
+
+AudioCache::AudioCache() : directory("cache/audio")
+{
+    memset(&allocationCallbacks, 0, sizeof(allocationCallbacks)); // padrão do miniaudio
+}
+
+void AudioCache::setAllocationCallbacks(const ma_allocation_callbacks& callbacks)
+{
+    allocationCallbacks = callbacks;
+}
+
+void AudioCache::setDirectory(const string& dir)
+{
+    directory = dir;
+}
+
+string AudioCache::cachePathFor(uint64_t sourceHash, ma_uint32 channels, ma_uint32 sampleRate) const
+{
+    return directory + "/" + hashToHex(sourceHash) + "_" + to_string(sampleRate) + "hz_" +
+           to_string(channels) + "ch.pcm";
+}
+
+bool AudioCache::load(const string& sourcePath, ma_uint32 channels, ma_uint32 sampleRate, CachedPCM& out)
+{
+    uint64_t sourceHash = 0;
+    if (!hashFile(sourcePath, sourceHash)) {
+        cerr << "Cache de áudio: não foi possível ler " << sourcePath << endl;
+        return false;
+    }
+
+    string cachePath = cachePathFor(sourceHash, channels, sampleRate);
+
+    // Caminho rápido: já existe uma versão decodificada válida
+    if (mapCacheFile(cachePath, sourceHash, channels, sampleRate, out)) {
+        return true;
+    }
+
+    // Primeira execução (ou cache inválido): decodifica e grava
+    if (!decodeToCache(sourcePath, cachePath, sourceHash, channels, sampleRate)) {
+        return false;
+    }
+    cout << "Cache de áudio criado: " << cachePath << endl;
+
+    return mapCacheFile(cachePath, sourceHash, channels, sampleRate, out);
+}
+
+bool AudioCache::mapCacheFile(const string& cachePath, uint64_t sourceHash, ma_uint32 channels, ma_uint32 sampleRate, CachedPCM& out)
+{
+    if (!out.file.open(cachePath)) return false;
+
+    const unsigned char* bytes = out.file.data();
+    size_t size = out.file.size();
+
+    PCMCacheHeader header;
+    if (size < sizeof(header)) {
+        out.file.close();
+        return false;
+    }
+    memcpy(&header, bytes, sizeof(header));
+
+    bool valid = memcmp(header.magic, PCM_CACHE_MAGIC, sizeof(PCM_CACHE_MAGIC)) == 0 &&
+                 header.version == PCM_CACHE_VERSION &&
+                 header.sourceHash == sourceHash &&
+                 header.channels == channels &&
+                 header.sampleRate == sampleRate &&
+                 header.channels > 0 &&
+                 header.dataOffset >= sizeof(header) &&
+                 header.dataOffset % sizeof(float) == 0 &&
+                 header.dataOffset <= size;
+
+    // Um cabeçalho corrompido não pode fazer o tamanho dar a volta:
+    // confere o produto antes de multiplicar e compara pelo espaço que sobra
+    if (valid) {
+        uint64_t maxFrames = (uint64_t)(size - header.dataOffset) / ((uint64_t)header.channels * sizeof(float));
+        valid = header.frameCount <= maxFrames;
+    }
+
+    if (!valid) {
+        out.file.close();
+        return false;
+    }
+
+    out.frames = reinterpret_cast<const float*>(bytes + header.dataOffset);
+    out.frameCount = header.frameCount;
+    out.channels = header.channels;
+    out.sampleRate = header.sampleRate;
+    return true;
+}
+
+bool AudioCache::decodeToCache(const string& sourcePath, const string& cachePath, uint64_t sourceHash, ma_uint32 channels, ma_uint32 sampleRate)
+{
+    if (!createDirectories(directory)) {
+        cerr << "Cache de áudio: não foi possível criar " << directory << endl;
+        return false;
+    }
+
+    // Decodifica já convertendo para o formato nativo do motor (f32)
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+    decoderConfig.allocationCallbacks = allocationCallbacks;
+    ma_uint64 frameCount = 0;
+    void* frames = NULL;
+    ma_result result = ma_decode_file(sourcePath.c_str(), &decoderConfig, &frameCount, &frames);
+    if (result != MA_SUCCESS) {
+        cerr << "Cache de áudio: erro ao decodificar " << sourcePath << endl;
+        return false;
+    }
+
+    PCMCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PCM_CACHE_MAGIC, sizeof(PCM_CACHE_MAGIC));
+    header.version = PCM_CACHE_VERSION;
+    header.channels = channels;
+    header.sampleRate = sampleRate;
+    header.dataOffset = ((sizeof(header) + PCM_CACHE_ALIGNMENT - 1) / PCM_CACHE_ALIGNMENT) * PCM_CACHE_ALIGNMENT;
+    header.frameCount = frameCount;
+    header.sourceHash = sourceHash;
+
+    size_t dataBytes = (size_t)(frameCount * channels * sizeof(float));
+    vector<unsigned char> fileData(header.dataOffset + dataBytes, 0);
+    memcpy(fileData.data(), &header, sizeof(header));
+    if (dataBytes > 0) {
+        memcpy(fileData.data() + header.dataOffset, frames, dataBytes);
+    }
+    ma_free(frames, &allocationCallbacks);
+
+    if (!writeFileAtomic(cachePath, fileData.data(), fileData.size())) {
+        cerr << "Cache de áudio: erro ao gravar " << cachePath << endl;
+        return false;
+    }
+    return true;
+}
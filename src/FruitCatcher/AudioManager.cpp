@@ -1,7 +1,12 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include "AudioManager.h"
 
-AudioManager::AudioManager() : initialized(false), musicLoaded(false) {
+#include <cmath>
+#include <new>
+
+AudioManager::AudioManager() : musicStreamed(false), reportedUnderruns(0), lastUnderrunLog(0.0), assetPack(nullptr), initialized(false), musicLoaded(false), loading(false), mixNanos(0), lastMixNanos(0) {
+    clockStart = chrono::steady_clock::now();
+    lastFrameTime = clockStart;
 }
 
 AudioManager::~AudioManager() {
@@ -9,7 +14,16 @@ AudioManager::~AudioManager() {
 }
 
 bool AudioManager::initialize() {
-    ma_result result = ma_engine_init(NULL, &engine);
+    AudioMemory::Scope memoryScope(AUDIO_MEM_ENGINE);
+
+    // Callback próprio do dispositivo só para medir o custo da mixagem
+    ma_engine_config engineConfig = ma_engine_config_init();
+    engineConfig.dataCallback = dataCallback;
+    engineConfig.pProcessUserData = this;
+    engineConfig.allocationCallbacks = memory.getCallbacks();
+    cache.setAllocationCallbacks(engineConfig.allocationCallbacks);
+
+    ma_result result = ma_engine_init(&engineConfig, &engine);
     if (result != MA_SUCCESS) {
         cerr << "Erro ao inicializar o motor de áudio." << endl;
         return false;
@@ -20,20 +34,84 @@ bool AudioManager::initialize() {
     return true;
 }
 
+shared_future<bool> AudioManager::initializeAsync(const string& musicPath, float musicVolume,
+                                                  const vector<SoundRequest>& effects) {
+    loading = true;
+    loadFuture = async(launch::async, [this, musicPath, musicVolume, effects]() {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        bool ok = initialize();
+        if (ok) {
+            if (loadMusic(musicPath)) {
+                setMusicVolume(musicVolume);
+                playMusic(true); // Tocar em loop
+            } else {
+                cout << "Aviso: Não foi possível carregar a música de fundo." << endl;
+            }
+
+            for (const SoundRequest& effect : effects) {
+                loadSound(effect.name, effect.filePath, effect.priority);
+            }
+
+            double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            cout << "Áudio pronto em " << elapsed << " ms (em segundo plano)" << endl;
+        } else {
+            cout << "Aviso: Sistema de áudio não inicializado." << endl;
+        }
+
+        loading = false;
+        return ok;
+    }).share();
+
+    return loadFuture;
+}
+
 bool AudioManager::loadMusic(const string& filePath) {
     if (!initialized) {
         cerr << "Sistema de áudio não foi inicializado!" << endl;
         return false;
     }
 
+    AudioMemory::Scope memoryScope(AUDIO_MEM_STREAM);
+
     // Se já tem música carregada, libera primeiro
     if (musicLoaded) {
         ma_sound_uninit(&music);
+        musicStream.close();
         musicLoaded = false;
     }
 
-    ma_result result = ma_sound_init_from_file(&engine, filePath.c_str(),
-        MA_SOUND_FLAG_STREAM, NULL, NULL, &music);
+    // Stream próprio: páginas de tamanho configurável decodificadas numa
+    // thread com prioridade ajustável, com contadores de underrun
+    ma_allocation_callbacks callbacks = memory.getCallbacks();
+    ma_uint32 channels = ma_engine_get_channels(&engine);
+    ma_uint32 sampleRate = ma_engine_get_sample_rate(&engine);
+    const PackEntry* packed = assetPack != nullptr ? assetPack->find(filePath) : nullptr;
+    if (packed != nullptr && packed->type == PACK_AUDIO_ENCODED) {
+        // Arquivo codificado lido direto do pacote mapeado
+        musicStreamed = musicStream.open(assetPack->entryData(*packed), (size_t)packed->dataSize,
+                                         channels, sampleRate, streamConfig, &callbacks);
+    } else {
+        musicStreamed = musicStream.open(filePath, channels, sampleRate, streamConfig, &callbacks);
+    }
+
+    ma_result result = MA_ERROR;
+    if (musicStreamed) {
+        result = ma_sound_init_from_data_source(&engine, musicStream.dataSource(), 0, NULL, &music);
+        if (result != MA_SUCCESS) {
+            musicStream.close();
+            musicStreamed = false;
+        }
+    }
+
+    if (!musicStreamed) {
+        // As páginas do stream do miniaudio são alocadas pela thread de jobs
+        // do resource manager, então a categoria padrão também muda aqui
+        memory.setDefaultCategory(AUDIO_MEM_STREAM);
+        result = ma_sound_init_from_file(&engine, filePath.c_str(),
+            MA_SOUND_FLAG_STREAM, NULL, NULL, &music);
+        memory.setDefaultCategory(AUDIO_MEM_ENGINE);
+    }
 
     if (result != MA_SUCCESS) {
         cerr << "Erro ao carregar música: " << filePath << endl;
@@ -41,7 +119,7 @@ bool AudioManager::loadMusic(const string& filePath) {
     }
 
     musicLoaded = true;
-    cout << "Música carregada: " << filePath << endl;
+    cout << "Música carregada: " << filePath << (musicStreamed ? "" : " [stream do miniaudio]") << endl;
     return true;
 }
 
@@ -59,7 +137,11 @@ void AudioManager::playMusic(bool loop) {
 void AudioManager::stopMusic() {
     if (musicLoaded) {
         ma_sound_stop(&music);
-        ma_sound_seek_to_pcm_frame(&music, 0); // Volta ao início
+        if (musicStreamed) {
+            musicStream.rewind(); // a thread de decodificação aplica a busca
+        } else {
+            ma_sound_seek_to_pcm_frame(&music, 0); // Volta ao início
+        }
     }
 }
 
@@ -91,66 +173,312 @@ bool AudioManager::isMusicPlaying() {
 
 // ===== EFEITOS SONOROS =====
 
-bool AudioManager::loadSound(const string& name, const string& filePath) {
+void AudioManager::setCacheDirectory(const string& dir) {
+    cache.setDirectory(dir);
+}
+
+void AudioManager::setMemoryBudget(size_t bytes) {
+    memory.setBudget(bytes);
+}
+
+void AudioManager::setBudget(const AudioBudget& newBudget) {
+    budget = newBudget;
+    if (budget.maxVoicesPerSound < 1) budget.maxVoicesPerSound = 1;
+    if (budget.maxTotalVoices < 1) budget.maxTotalVoices = 1;
+}
+
+bool AudioManager::loadSound(const string& name, const string& filePath, int priority) {
     if (!initialized) {
         cerr << "Sistema de áudio não foi inicializado!" << endl;
         return false;
     }
 
-    // Se já existe um som com esse nome, libera primeiro
-    if (sounds.find(name) != sounds.end()) {
-        ma_sound_uninit(sounds[name]);
-        delete sounds[name];
-        sounds.erase(name);
+    AudioMemory::Scope memoryScope(AUDIO_MEM_SFX);
+
+    // Vozes alocadas pelo alocador rastreado, dentro do orçamento de memória
+    void* voiceMemory = memory.allocate(sizeof(Voice) * budget.maxVoicesPerSound, AUDIO_MEM_SFX);
+    if (voiceMemory == nullptr) {
+        cerr << "Erro ao carregar som '" << name << "': memória de áudio esgotada" << endl;
+        return false;
+    }
+
+    SoundEntry* entry = new SoundEntry();
+    entry->priority = priority;
+    entry->voiceCount = budget.maxVoicesPerSound;
+    entry->voices = (Voice*)voiceMemory;
+    for (int i = 0; i < entry->voiceCount; i++) {
+        new (&entry->voices[i]) Voice();
     }
 
-    // Criar novo som
-    ma_sound* sound = new ma_sound();
-    ma_result result = ma_sound_init_from_file(&engine, filePath.c_str(),
-        MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC, NULL, NULL, sound);
+    // PCM pronto: primeiro no pacote de assets, depois no cache (ambos mapeados)
+    const PackEntry* packed = assetPack != nullptr ? assetPack->find(filePath) : nullptr;
+    bool fromPack = packed != nullptr && packed->type == PACK_AUDIO_PCM;
+    if (fromPack) {
+        entry->cached.frames = reinterpret_cast<const float*>(assetPack->entryData(*packed));
+        entry->cached.frameCount = packed->frameCount;
+        entry->cached.channels = packed->channels;
+        entry->cached.sampleRate = packed->sampleRate; // repassado à voz em initVoice()
+        entry->mappedBytes = (size_t)packed->dataSize;
+        entry->fromCache = true;
+    } else {
+        ma_uint32 channels = ma_engine_get_channels(&engine);
+        ma_uint32 sampleRate = ma_engine_get_sample_rate(&engine);
+        entry->fromCache = cache.load(filePath, channels, sampleRate, entry->cached);
+        entry->mappedBytes = entry->fromCache ? entry->cached.file.size() : 0;
+    }
 
-    if (result != MA_SUCCESS) {
+    // O PCM mapeado também conta no orçamento
+    if (entry->fromCache && !memory.reserveMapped(entry->mappedBytes)) {
+        cerr << "Aviso: PCM de '" << name << "' não cabe no orçamento de memória de áudio" << endl;
+        entry->fromCache = false;
+        entry->cached.file.close();
+    }
+
+    // A primeira voz define se o som carregou; as demais são cópias baratas
+    bool ok = initVoice(entry, 0, filePath);
+    if (!ok && entry->fromCache) {
+        // Fallback: decodifica o arquivo original como antes
+        memory.releaseMapped(entry->mappedBytes);
+        entry->fromCache = false;
+        entry->cached.file.close();
+        ok = initVoice(entry, 0, filePath);
+    }
+
+    if (!ok) {
         cerr << "Erro ao carregar som '" << name << "': " << filePath << endl;
-        delete sound;
+        releaseSound(entry);
         return false;
     }
 
-    sounds[name] = sound;
-    cout << "Som carregado: " << name << " (" << filePath << ")" << endl;
+    for (int i = 1; i < entry->voiceCount; i++) {
+        if (!initVoice(entry, i, filePath)) {
+            entry->voiceCount = i; // segue com as vozes que conseguiu criar
+            break;
+        }
+    }
+
+    // Publica o som (substituindo um anterior com o mesmo nome)
+    SoundEntry* previous = nullptr;
+    {
+        lock_guard<mutex> guard(soundsLock);
+        auto it = sounds.find(name);
+        if (it != sounds.end()) previous = it->second;
+        sounds[name] = entry;
+    }
+    if (previous != nullptr) {
+        releaseSound(previous);
+    }
+
+    cout << "Som carregado: " << name << " (" << filePath << ")"
+         << (fromPack && entry->fromCache ? " [pacote]" : entry->fromCache ? " [cache PCM]" : "") << " - " << entry->voiceCount << " vozes" << endl;
+    return true;
+}
+
+bool AudioManager::initVoice(SoundEntry* entry, int index, const string& filePath) {
+    Voice& voice = entry->voices[index];
+    ma_result result;
+
+    if (entry->fromCache) {
+        // Cada voz tem seu próprio cursor sobre o mesmo PCM mapeado
+        result = ma_audio_buffer_ref_init(ma_format_f32, entry->cached.channels,
+            entry->cached.frames, entry->cached.frameCount, &voice.buffer);
+        if (result != MA_SUCCESS) return false;
+        // ma_audio_buffer_ref_init deixa a taxa em 0 (= taxa do motor); com a taxa
+        // real o ma_sound converte o PCM do pacote quando difere da do dispositivo
+        voice.buffer.sampleRate = entry->cached.sampleRate;
+
+        result = ma_sound_init_from_data_source(&engine, &voice.buffer, 0, NULL, &voice.sound);
+        if (result != MA_SUCCESS) {
+            ma_audio_buffer_ref_uninit(&voice.buffer);
+            return false;
+        }
+    } else if (index == 0) {
+        // Sem ASYNC: a decodificação acontece aqui, contada como AUDIO_MEM_SFX
+        result = ma_sound_init_from_file(&engine, filePath.c_str(),
+            MA_SOUND_FLAG_DECODE, NULL, NULL, &voice.sound);
+        if (result != MA_SUCCESS) return false;
+    } else {
+        // Cópias compartilham os dados decodificados pelo resource manager
+        result = ma_sound_init_copy(&engine, &entry->voices[0].sound, 0, NULL, &voice.sound);
+        if (result != MA_SUCCESS) return false;
+    }
+
+    voice.initialized = true;
     return true;
 }
 
+double AudioManager::now() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - clockStart).count();
+}
+
+int AudioManager::countActiveVoices() {
+    int active = 0;
+    for (auto& pair : sounds) {
+        SoundEntry* entry = pair.second;
+        for (int i = 0; i < entry->voiceCount; i++) {
+            if (ma_sound_is_playing(&entry->voices[i].sound)) active++;
+        }
+    }
+    return active;
+}
+
+void AudioManager::startVoice(SoundEntry* entry, int index, float volume) {
+    Voice& voice = entry->voices[index];
+
+    if (ma_sound_is_playing(&voice.sound)) {
+        ma_sound_stop(&voice.sound);
+    }
+    ma_sound_seek_to_pcm_frame(&voice.sound, 0); // Volta ao início
+    ma_sound_set_volume(&voice.sound, volume);
+    ma_sound_start(&voice.sound);
+
+    voice.volume = volume;
+    voice.startTime = now();
+    entry->lastVoice = index;
+}
+
 void AudioManager::playSound(const string& name, float volume) {
     if (!initialized) return;
 
-    // Verificar se o som existe
+    lock_guard<mutex> guard(soundsLock);
+
+    // Verificar se o som existe (durante a carga em segundo plano, só ignora)
     if (sounds.find(name) == sounds.end()) {
-        cerr << "Som '" << name << "' não foi carregado!" << endl;
+        if (!loading) {
+            cerr << "Som '" << name << "' não foi carregado!" << endl;
+        }
         return;
     }
 
-    ma_sound* sound = sounds[name];
+    SoundEntry* entry = sounds[name];
 
     // Configurar volume
     if (volume < 0.0f) volume = 0.0f;
     if (volume > 1.0f) volume = 1.0f;
-    ma_sound_set_volume(sound, volume);
 
-    // Parar o som se já estiver tocando e reiniciar
-    if (ma_sound_is_playing(sound)) {
-        ma_sound_stop(sound);
+    double time = now();
+
+    // 1) Disparos quase simultâneos do mesmo som: aumenta o volume da voz
+    //    mais recente em vez de abrir outra (soma de energia, limitada a 1.0)
+    if (entry->lastVoice >= 0) {
+        Voice& last = entry->voices[entry->lastVoice];
+        if ((time - last.startTime) * 1000.0 <= budget.coalesceWindowMs && ma_sound_is_playing(&last.sound)) {
+            last.volume = fmin(1.0f, sqrtf(last.volume * last.volume + volume * volume));
+            ma_sound_set_volume(&last.sound, last.volume);
+            stats.coalescedTriggers++;
+            return;
+        }
+    }
+
+    // 2) Limite por som: usa uma voz livre ou reinicia a mais antiga do pool
+    int index = -1;
+    for (int i = 0; i < entry->voiceCount; i++) {
+        if (!ma_sound_is_playing(&entry->voices[i].sound)) {
+            index = i;
+            break;
+        }
+        if (index < 0 || entry->voices[i].startTime < entry->voices[index].startTime) {
+            index = i;
+        }
+    }
+
+    // 3) Limite global: se for abrir uma voz nova e já estamos no máximo,
+    //    corta a voz de menor prioridade (a mais antiga, em caso de empate)
+    bool addsVoice = !ma_sound_is_playing(&entry->voices[index].sound);
+    if (addsVoice && countActiveVoices() >= budget.maxTotalVoices) {
+        SoundEntry* victimEntry = nullptr;
+        int victimIndex = -1;
+        for (auto& pair : sounds) {
+            SoundEntry* other = pair.second;
+            for (int i = 0; i < other->voiceCount; i++) {
+                Voice& candidate = other->voices[i];
+                if (!ma_sound_is_playing(&candidate.sound)) continue;
+                if (victimEntry == nullptr || other->priority < victimEntry->priority ||
+                    (other->priority == victimEntry->priority &&
+                     candidate.startTime < victimEntry->voices[victimIndex].startTime)) {
+                    victimEntry = other;
+                    victimIndex = i;
+                }
+            }
+        }
+
+        if (victimEntry == nullptr || victimEntry->priority > entry->priority) {
+            stats.culledTriggers++;
+            return;
+        }
+
+        ma_sound_stop(&victimEntry->voices[victimIndex].sound);
+        stats.stolenVoices++;
+    }
+    else if (!addsVoice) {
+        stats.stolenVoices++;
+    }
+
+    startVoice(entry, index, volume);
+}
+
+AudioStats AudioManager::getStats() {
+    lock_guard<mutex> guard(soundsLock);
+    return stats;
+}
+
+void AudioManager::endFrame() {
+    if (!initialized) return;
+
+    chrono::steady_clock::time_point frameTime = chrono::steady_clock::now();
+    double wallNanos = (double)chrono::duration_cast<chrono::nanoseconds>(frameTime - lastFrameTime).count();
+    lastFrameTime = frameTime;
+
+    unsigned long long total = mixNanos.load(memory_order_relaxed);
+    unsigned long long delta = total - lastMixNanos;
+    lastMixNanos = total;
+
+    {
+        lock_guard<mutex> guard(soundsLock);
+        stats.mixTimeMs = delta / 1.0e6;
+        if (stats.mixTimeMs > stats.peakMixTimeMs) stats.peakMixTimeMs = stats.mixTimeMs;
+        stats.mixLoad = wallNanos > 0.0 ? delta / wallNanos : 0.0;
+
+        stats.activeVoices = countActiveVoices();
+        if (stats.activeVoices > stats.peakVoices) stats.peakVoices = stats.activeVoices;
+    }
+
+    // Underruns da música: no máximo um aviso por segundo
+    if (musicStreamed) {
+        MusicStreamStats streamStats = musicStream.getStats();
+        double time = now();
+        if (streamStats.underruns > reportedUnderruns && time - lastUnderrunLog >= 1.0) {
+            cerr << "Áudio: " << streamStats.underruns - reportedUnderruns << " underrun(s) no stream da música"
+                 << " (decodificação da última página: " << streamStats.lastPageDecodeMs << " ms)" << endl;
+            reportedUnderruns = streamStats.underruns;
+            lastUnderrunLog = time;
+        }
     }
-    ma_sound_seek_to_pcm_frame(sound, 0); // Volta ao início
+}
+
+void AudioManager::dataCallback(ma_device* device, void* output, const void* input, ma_uint32 frameCount) {
+    (void)input;
+    ma_engine* engine = (ma_engine*)device->pUserData;
+    AudioManager* self = (AudioManager*)engine->pProcessUserData;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    ma_engine_read_pcm_frames(engine, output, frameCount, NULL);
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
 
-    // Tocar o som
-    ma_sound_start(sound);
+    self->mixNanos.fetch_add((unsigned long long)chrono::duration_cast<chrono::nanoseconds>(end - start).count(),
+                             memory_order_relaxed);
 }
 
 void AudioManager::cleanup() {
+    // Espera a carga em segundo plano terminar antes de desmontar o motor
+    if (loadFuture.valid()) {
+        loadFuture.wait();
+    }
+
     // Limpar efeitos sonoros
+    lock_guard<mutex> guard(soundsLock);
     for (auto& pair : sounds) {
-        ma_sound_uninit(pair.second);
-        delete pair.second;
+        releaseSound(pair.second);
     }
     sounds.clear();
 
@@ -159,9 +487,32 @@ void AudioManager::cleanup() {
         ma_sound_uninit(&music);
         musicLoaded = false;
     }
+    musicStream.close();
+    musicStreamed = false;
 
     if (initialized) {
         ma_engine_uninit(&engine);
         initialized = false;
     }
 }
+
+void AudioManager::releaseSound(SoundEntry* entry) {
+    // Cópias primeiro: a voz 0 é dona dos dados no fallback sem cache
+    for (int i = entry->voiceCount - 1; i >= 0; i--) {
+        Voice& voice = entry->voices[i];
+        if (!voice.initialized) continue;
+        ma_sound_uninit(&voice.sound);
+        if (entry->fromCache) {
+            ma_audio_buffer_ref_uninit(&voice.buffer);
+        }
+    }
+    for (int i = 0; i < entry->voiceCount; i++) {
+        entry->voices[i].~Voice();
+    }
+    memory.release(entry->voices);
+
+    if (entry->fromCache) {
+        memory.releaseMapped(entry->mappedBytes);
+    }
+    delete entry; // desmapeia o arquivo do cache
+}
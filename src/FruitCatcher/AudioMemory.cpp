@@ -0,0 +1,238 @@
+#include "AudioMemory.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+// Cabeçalho na frente de cada alocação (16 bytes mantém o alinhamento do malloc)
+struct AllocHeader {
+    uint64_t size;       // bytes pedidos
+    uint16_t category;
+    uint16_t sizeClass;  // índice da classe do pool, ou DIRECT_ALLOCATION
+    uint32_t reserved;
+};
+
+static const uint16_t DIRECT_ALLOCATION = 0xFFFF;
+static const size_t POOL_CHUNK_SIZE = 64 * 1024;
+static const size_t POOL_CLASS_SIZES[] = {64, 128, 256, 512, 1024, 2048}; // incluindo o cabeçalho
+static const int POOL_CLASS_COUNT = sizeof(POOL_CLASS_SIZES) / sizeof(POOL_CLASS_SIZES[0]);
+
+// -1 = thread sem escopo (usa a categoria padrão do AudioMemory)
+static thread_local int currentCategory = -1;
+
+static int sizeClassFor(size_t size)
+{
+    size_t blockSize = size + sizeof(AllocHeader);
+    for (int i = 0; i < POOL_CLASS_COUNT; i++) {
+        if (blockSize <= POOL_CLASS_SIZES[i]) return i;
+    }
+    return -1;
+}
+
+AudioMemory::AudioMemory() : defaultCategory(AUDIO_MEM_ENGINE), freeLists(POOL_CLASS_COUNT, nullptr)
+{
+}
+
+AudioMemory::~AudioMemory()
+{
+    for (void* chunk : chunks) {
+        free(chunk);
+    }
+}
+
+void AudioMemory::setBudget(size_t bytes)
+{
+    lock_guard<mutex> guard(lock);
+    stats.budgetBytes = bytes;
+}
+
+void AudioMemory::setDefaultCategory(AudioMemCategory category)
+{
+    defaultCategory = category;
+}
+
+AudioMemCategory AudioMemory::categoryForThread() const
+{
+    return (AudioMemCategory)(currentCategory >= 0 ? currentCategory : defaultCategory.load());
+}
+
+ma_allocation_callbacks AudioMemory::getCallbacks()
+{
+    ma_allocation_callbacks callbacks;
+    callbacks.pUserData = this;
+    callbacks.onMalloc = onMalloc;
+    callbacks.onRealloc = onRealloc;
+    callbacks.onFree = onFree;
+    return callbacks;
+}
+
+bool AudioMemory::fitsBudget(size_t extraBytes) const
+{
+    return stats.budgetBytes == 0 || stats.totalBytes + extraBytes <= stats.budgetBytes;
+}
+
+void AudioMemory::account(AudioMemCategory category, size_t bytes, bool add)
+{
+    if (add) {
+        stats.bytesInUse[category] += bytes;
+        stats.totalBytes += bytes;
+        if (stats.totalBytes > stats.peakBytes) stats.peakBytes = stats.totalBytes;
+    } else {
+        stats.bytesInUse[category] -= bytes;
+        stats.totalBytes -= bytes;
+    }
+}
+
+void* AudioMemory::allocateFromPool(int sizeClass)
+{
+    if (freeLists[sizeClass] == nullptr) {
+        // Lista vazia: fatia um bloco novo de 64 KB nesta classe
+        unsigned char* chunk = (unsigned char*)malloc(POOL_CHUNK_SIZE);
+        if (chunk == nullptr) return nullptr;
+        chunks.push_back(chunk);
+        stats.poolReservedBytes += POOL_CHUNK_SIZE;
+
+        size_t blockSize = POOL_CLASS_SIZES[sizeClass];
+        for (size_t offset = 0; offset + blockSize <= POOL_CHUNK_SIZE; offset += blockSize) {
+            void* block = chunk + offset;
+            *(void**)block = freeLists[sizeClass];
+            freeLists[sizeClass] = block;
+        }
+    }
+
+    void* block = freeLists[sizeClass];
+    freeLists[sizeClass] = *(void**)block;
+    return block;
+}
+
+void* AudioMemory::allocate(size_t size, AudioMemCategory category)
+{
+    lock_guard<mutex> guard(lock);
+
+    if (!fitsBudget(size)) {
+        if (stats.failedAllocations++ == 0) {
+            cerr << "Áudio: orçamento de memória excedido (" << stats.totalBytes + size
+                 << " > " << stats.budgetBytes << " bytes)" << endl;
+        }
+        return nullptr;
+    }
+
+    int sizeClass = sizeClassFor(size);
+    AllocHeader* header = (AllocHeader*)(sizeClass >= 0 ? allocateFromPool(sizeClass)
+                                                        : malloc(size + sizeof(AllocHeader)));
+    if (header == nullptr) {
+        stats.failedAllocations++;
+        return nullptr;
+    }
+
+    header->size = size;
+    header->category = (uint16_t)category;
+    header->sizeClass = sizeClass >= 0 ? (uint16_t)sizeClass : DIRECT_ALLOCATION;
+    header->reserved = 0;
+
+    account(category, size, true);
+    return header + 1;
+}
+
+void AudioMemory::release(void* ptr)
+{
+    if (ptr == nullptr) return;
+
+    lock_guard<mutex> guard(lock);
+
+    AllocHeader* header = (AllocHeader*)ptr - 1;
+    account((AudioMemCategory)header->category, (size_t)header->size, false);
+
+    if (header->sizeClass == DIRECT_ALLOCATION) {
+        free(header);
+    } else {
+        *(void**)header = freeLists[header->sizeClass];
+        freeLists[header->sizeClass] = header;
+    }
+}
+
+void* AudioMemory::reallocate(void* ptr, size_t size)
+{
+    if (ptr == nullptr) return allocate(size, categoryForThread());
+    if (size == 0) {
+        release(ptr);
+        return nullptr;
+    }
+
+    AllocHeader* header = (AllocHeader*)ptr - 1;
+    AudioMemCategory category = (AudioMemCategory)header->category;
+    size_t oldSize = (size_t)header->size;
+
+    // Ainda cabe no mesmo bloco do pool: só ajusta a contagem
+    if (header->sizeClass != DIRECT_ALLOCATION && size + sizeof(AllocHeader) <= POOL_CLASS_SIZES[header->sizeClass]) {
+        lock_guard<mutex> guard(lock);
+        if (size > oldSize && !fitsBudget(size - oldSize)) {
+            stats.failedAllocations++;
+            return nullptr;
+        }
+        account(category, oldSize, false);
+        account(category, size, true);
+        header->size = size;
+        return ptr;
+    }
+
+    void* newPtr = allocate(size, category);
+    if (newPtr == nullptr) return nullptr; // o bloco antigo continua válido
+    memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+    release(ptr);
+    return newPtr;
+}
+
+bool AudioMemory::reserveMapped(size_t bytes)
+{
+    lock_guard<mutex> guard(lock);
+    if (!fitsBudget(bytes)) {
+        stats.failedAllocations++;
+        return false;
+    }
+    stats.mappedBytes += bytes;
+    account(AUDIO_MEM_SFX, bytes, true);
+    return true;
+}
+
+void AudioMemory::releaseMapped(size_t bytes)
+{
+    lock_guard<mutex> guard(lock);
+    stats.mappedBytes -= bytes;
+    account(AUDIO_MEM_SFX, bytes, false);
+}
+
+AudioMemoryStats AudioMemory::getStats()
+{
+    lock_guard<mutex> guard(lock);
+    return stats;
+}
+
+void* AudioMemory::onMalloc(size_t size, void* userData)
+{
+    AudioMemory* self = (AudioMemory*)userData;
+    return self->allocate(size, self->categoryForThread());
+}
+
+void* AudioMemory::onRealloc(void* ptr, size_t size, void* userData)
+{
+    return ((AudioMemory*)userData)->reallocate(ptr, size);
+}
+
+void AudioMemory::onFree(void* ptr, void* userData)
+{
+    ((AudioMemory*)userData)->release(ptr);
+}
+
+// ===== ESCOPO DE CATEGORIA =====
+
+AudioMemory::Scope::Scope(AudioMemCategory category) : previous(currentCategory)
+{
+    currentCategory = category;
+}
+
+AudioMemory::Scope::~Scope()
+{
+    currentCategory = previous;
+}
@@ -0,0 +1,277 @@
+#include "BC7.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+// Pesos de interpolação dos índices de 4 bits (em 64 avos)
+static const int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+size_t bc7ImageSize(int width, int height)
+{
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * 16;
+}
+
+// Extremos já quantizados: 7 bits por canal + bit p (compartilhado pelos canais)
+struct Mode6Endpoints {
+    int color[2][4]; // 0..127
+    int p[2];
+};
+
+static void expandEndpoint(const Mode6Endpoints& endpoints, int which, int out[4])
+{
+    for (int c = 0; c < 4; c++) {
+        out[c] = (endpoints.color[which][c] << 1) | endpoints.p[which];
+    }
+}
+
+static void buildPalette(const Mode6Endpoints& endpoints, int palette[16][4])
+{
+    int a[4], b[4];
+    expandEndpoint(endpoints, 0, a);
+    expandEndpoint(endpoints, 1, b);
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 4; c++) {
+            palette[i][c] = ((64 - BC7_WEIGHTS[i]) * a[c] + BC7_WEIGHTS[i] * b[c] + 32) >> 6;
+        }
+    }
+}
+
+// Escolhe o melhor índice de cada pixel; devolve o erro quadrático total
+static int assignIndices(const unsigned char pixels[16][4], const Mode6Endpoints& endpoints, int indices[16])
+{
+    int palette[16][4];
+    buildPalette(endpoints, palette);
+
+    int total = 0;
+    for (int i = 0; i < 16; i++) {
+        int bestError = INT32_MAX;
+        for (int k = 0; k < 16; k++) {
+            int error = 0;
+            for (int c = 0; c < 4; c++) {
+                int d = palette[k][c] - pixels[i][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                indices[i] = k;
+            }
+        }
+        total += bestError;
+    }
+    return total;
+}
+
+// Quantiza os extremos em float testando as 4 combinações de bits p
+static int quantizeEndpoints(const unsigned char pixels[16][4], const float ends[2][4],
+                             Mode6Endpoints& best, int indices[16])
+{
+    int bestError = INT32_MAX;
+    for (int p0 = 0; p0 < 2; p0++) {
+        for (int p1 = 0; p1 < 2; p1++) {
+            Mode6Endpoints candidate;
+            candidate.p[0] = p0;
+            candidate.p[1] = p1;
+            for (int e = 0; e < 2; e++) {
+                for (int c = 0; c < 4; c++) {
+                    int q = (int)floor((ends[e][c] - candidate.p[e]) / 2.0f + 0.5f);
+                    candidate.color[e][c] = min(127, max(0, q));
+                }
+            }
+
+            int candidateIndices[16];
+            int error = assignIndices(pixels, candidate, candidateIndices);
+            if (error < bestError) {
+                bestError = error;
+                best = candidate;
+                memcpy(indices, candidateIndices, sizeof(candidateIndices));
+            }
+        }
+    }
+    return bestError;
+}
+
+// Eixo principal (PCA) das cores do bloco, por iteração de potência
+static void principalAxis(const unsigned char pixels[16][4], const float mean[4], float axis[4])
+{
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; i++) {
+        float d[4];
+        for (int c = 0; c < 4; c++) d[c] = pixels[i][c] - mean[c];
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 4; c++) cov[r][c] += d[r] * d[c];
+        }
+    }
+
+    for (int c = 0; c < 4; c++) axis[c] = cov[c][c] + 1.0f;
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[4] = {};
+        for (int r = 0; r < 4; r++) {
+            for (int c = 0; c < 4; c++) next[r] += cov[r][c] * axis[c];
+        }
+        float length = sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 4; c++) axis[c] = next[c] / length;
+    }
+}
+
+// Mínimos quadrados: extremos que melhor reproduzem os pixels com estes índices
+static bool refitEndpoints(const unsigned char pixels[16][4], const int indices[16], float ends[2][4])
+{
+    float aa = 0, ab = 0, bb = 0;
+    float ra[4] = {}, rb[4] = {};
+    for (int i = 0; i < 16; i++) {
+        float w = BC7_WEIGHTS[indices[i]] / 64.0f;
+        aa += (1 - w) * (1 - w);
+        ab += (1 - w) * w;
+        bb += w * w;
+        for (int c = 0; c < 4; c++) {
+            ra[c] += (1 - w) * pixels[i][c];
+            rb[c] += w * pixels[i][c];
+        }
+    }
+
+    float det = aa * bb - ab * ab;
+    if (fabs(det) < 1e-6f) return false;
+    for (int c = 0; c < 4; c++) {
+        ends[0][c] = min(255.0f, max(0.0f, (bb * ra[c] - ab * rb[c]) / det));
+        ends[1][c] = min(255.0f, max(0.0f, (aa * rb[c] - ab * ra[c]) / det));
+    }
+    return true;
+}
+
+static void writeBits(unsigned char* block, int& position, uint32_t value, int bits)
+{
+    for (int i = 0; i < bits; i++, position++) {
+        if ((value >> i) & 1) block[position >> 3] |= (unsigned char)(1 << (position & 7));
+    }
+}
+
+static uint32_t readBits(const unsigned char* block, int& position, int bits)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < bits; i++, position++) {
+        value |= (uint32_t)((block[position >> 3] >> (position & 7)) & 1) << i;
+    }
+    return value;
+}
+
+static void encodeBlock(const unsigned char pixels[16][4], unsigned char* block)
+{
+    float mean[4] = {};
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 4; c++) mean[c] += pixels[i][c] / 16.0f;
+    }
+
+    // Extremos iniciais: projeções extremas no eixo principal
+    float axis[4];
+    principalAxis(pixels, mean, axis);
+    float tMin = 0.0f, tMax = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        float t = 0.0f;
+        for (int c = 0; c < 4; c++) t += (pixels[i][c] - mean[c]) * axis[c];
+        tMin = min(tMin, t);
+        tMax = max(tMax, t);
+    }
+    float ends[2][4];
+    for (int c = 0; c < 4; c++) {
+        ends[0][c] = min(255.0f, max(0.0f, mean[c] + axis[c] * tMin));
+        ends[1][c] = min(255.0f, max(0.0f, mean[c] + axis[c] * tMax));
+    }
+
+    Mode6Endpoints endpoints;
+    int indices[16];
+    int error = quantizeEndpoints(pixels, ends, endpoints, indices);
+
+    // Um ajuste por mínimos quadrados costuma reduzir bem o erro
+    if (error > 0 && refitEndpoints(pixels, indices, ends)) {
+        Mode6Endpoints refined;
+        int refinedIndices[16];
+        if (quantizeEndpoints(pixels, ends, refined, refinedIndices) < error) {
+            endpoints = refined;
+            memcpy(indices, refinedIndices, sizeof(indices));
+        }
+    }
+
+    // O índice do pixel 0 é gravado com 3 bits: o bit alto precisa ser 0
+    if (indices[0] & 8) {
+        for (int c = 0; c < 4; c++) swap(endpoints.color[0][c], endpoints.color[1][c]);
+        swap(endpoints.p[0], endpoints.p[1]);
+        for (int i = 0; i < 16; i++) indices[i] = 15 - indices[i];
+    }
+
+    memset(block, 0, 16);
+    int position = 0;
+    writeBits(block, position, 1 << 6, 7); // modo 6
+    for (int c = 0; c < 4; c++) {
+        writeBits(block, position, endpoints.color[0][c], 7);
+        writeBits(block, position, endpoints.color[1][c], 7);
+    }
+    writeBits(block, position, endpoints.p[0], 1);
+    writeBits(block, position, endpoints.p[1], 1);
+    writeBits(block, position, indices[0], 3);
+    for (int i = 1; i < 16; i++) {
+        writeBits(block, position, indices[i], 4);
+    }
+}
+
+void encodeBC7(const unsigned char* rgba, int width, int height, vector<unsigned char>& blocks)
+{
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    blocks.assign(bc7ImageSize(width, height), 0);
+
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            unsigned char pixels[16][4];
+            for (int i = 0; i < 16; i++) {
+                int x = min(bx * 4 + i % 4, width - 1);
+                int y = min(by * 4 + i / 4, height - 1);
+                memcpy(pixels[i], rgba + ((size_t)y * width + x) * 4, 4);
+            }
+            encodeBlock(pixels, blocks.data() + ((size_t)by * blocksX + bx) * 16);
+        }
+    }
+}
+
+void decodeBC7(const unsigned char* blocks, int width, int height, unsigned char* rgba)
+{
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+
+    for (int by = 0; by < blocksY; by++) {
+        for (int bx = 0; bx < blocksX; bx++) {
+            const unsigned char* block = blocks + ((size_t)by * blocksX + bx) * 16;
+            int position = 0;
+
+            int palette[16][4];
+            int indices[16];
+            if (readBits(block, position, 7) == (1 << 6)) {
+                Mode6Endpoints endpoints;
+                for (int c = 0; c < 4; c++) {
+                    endpoints.color[0][c] = readBits(block, position, 7);
+                    endpoints.color[1][c] = readBits(block, position, 7);
+                }
+                endpoints.p[0] = readBits(block, position, 1);
+                endpoints.p[1] = readBits(block, position, 1);
+                buildPalette(endpoints, palette);
+
+                indices[0] = readBits(block, position, 3);
+                for (int i = 1; i < 16; i++) indices[i] = readBits(block, position, 4);
+            } else {
+                // Outros modos não são gerados pelo fruitcatcher_cook: transparente
+                memset(palette, 0, sizeof(palette));
+                memset(indices, 0, sizeof(indices));
+            }
+
+            for (int i = 0; i < 16; i++) {
+                int x = bx * 4 + i % 4;
+                int y = by * 4 + i / 4;
+                if (x >= width || y >= height) continue;
+                unsigned char* out = rgba + ((size_t)y * width + x) * 4;
+                for (int c = 0; c < 4; c++) out[c] = (unsigned char)palette[indices[i]][c];
+            }
+        }
+    }
+}
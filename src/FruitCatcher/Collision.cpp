@@ -0,0 +1,187 @@
+#include "Collision.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_SSE 1
+#include <xmmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define COLLISION_AVX 1
+#include <immintrin.h>
+#endif
+#endif
+
+// Ordem dos campos usada pelos kernels (uma caixa = 4 floats = 16 bytes)
+static_assert(sizeof(AABB) == 4 * sizeof(float), "AABB precisa ser 4 floats contíguos");
+
+static void setHit(uint64_t* hits, size_t index)
+{
+    hits[index >> 6] |= (uint64_t)1 << (index & 63);
+}
+
+static size_t countBits(uint32_t mask)
+{
+    size_t count = 0;
+    for (; mask != 0; mask &= mask - 1) count++;
+    return count;
+}
+
+// Resto do lote (e caminho sem SIMD): mesma regra do overlaps
+static size_t overlapScalar(const AABB& box, const AABB* boxes, size_t first, size_t count, uint64_t* hits)
+{
+    size_t total = 0;
+    for (size_t i = first; i < count; i++) {
+        if (overlaps(box, boxes[i])) {
+            setHit(hits, i);
+            total++;
+        }
+    }
+    return total;
+}
+
+// Intervalo [entry, exit] em que as projeções num eixo se sobrepõem, com
+// 'moving' andando 'velocity' por passo e a outra parada
+static bool sweepAxis(float movingMin, float movingMax, float targetMin, float targetMax, float velocity,
+                      float& entry, float& exit)
+{
+    if (velocity == 0.0f) {
+        entry = -numeric_limits<float>::infinity();
+        exit = numeric_limits<float>::infinity();
+        return movingMax >= targetMin && targetMax >= movingMin;
+    }
+    float first = (targetMin - movingMax) / velocity;
+    float last = (targetMax - movingMin) / velocity;
+    entry = min(first, last);
+    exit = max(first, last);
+    return true;
+}
+
+bool sweepAABB(const AABB& moving, float dx, float dy,
+               const AABB& target, float targetDx, float targetDy, float& timeOfImpact)
+{
+    // Movimento relativo: o alvo fica parado
+    float velocityX = dx - targetDx;
+    float velocityY = dy - targetDy;
+
+    float entryX, exitX, entryY, exitY;
+    if (!sweepAxis(moving.minX, moving.maxX, target.minX, target.maxX, velocityX, entryX, exitX)) return false;
+    if (!sweepAxis(moving.minY, moving.maxY, target.minY, target.maxY, velocityY, entryY, exitY)) return false;
+
+    float entry = max(entryX, entryY);
+    float exit = min(exitX, exitY);
+    if (entry > exit || entry > 1.0f || exit < 0.0f) return false;
+
+    timeOfImpact = max(entry, 0.0f);
+    return true;
+}
+
+#ifdef COLLISION_SSE
+// 4 caixas por vez: a transposta 4x4 separa minX, minY, maxX e maxY
+static size_t overlapSSE(const AABB& box, const AABB* boxes, size_t count, uint64_t* hits)
+{
+    const __m128 boxMinX = _mm_set1_ps(box.minX);
+    const __m128 boxMinY = _mm_set1_ps(box.minY);
+    const __m128 boxMaxX = _mm_set1_ps(box.maxX);
+    const __m128 boxMaxY = _mm_set1_ps(box.maxY);
+    const float* data = &boxes[0].minX;
+
+    size_t total = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 minX = _mm_loadu_ps(data + i * 4);
+        __m128 minY = _mm_loadu_ps(data + i * 4 + 4);
+        __m128 maxX = _mm_loadu_ps(data + i * 4 + 8);
+        __m128 maxY = _mm_loadu_ps(data + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(minX, minY, maxX, maxY);
+
+        __m128 hit = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(minX, boxMaxX), _mm_cmpge_ps(maxX, boxMinX)),
+                                _mm_and_ps(_mm_cmple_ps(minY, boxMaxY), _mm_cmpge_ps(maxY, boxMinY)));
+        uint32_t mask = (uint32_t)_mm_movemask_ps(hit);
+        if (mask != 0) {
+            // i é múltiplo de 4: os 4 bits nunca cruzam a palavra
+            hits[i >> 6] |= (uint64_t)mask << (i & 63);
+            total += countBits(mask);
+        }
+    }
+    return total + overlapScalar(box, boxes, i, count, hits);
+}
+#endif
+
+#ifdef COLLISION_AVX
+// 8 caixas por vez: cada metade do registrador recebe 4 caixas (i..i+3 e
+// i+4..i+7) e a transposta é feita por metade, então o bit k da máscara já
+// é a caixa i + k
+__attribute__((target("avx"))) static size_t overlapAVX(const AABB& box, const AABB* boxes, size_t count, uint64_t* hits)
+{
+    const __m256 boxMinX = _mm256_set1_ps(box.minX);
+    const __m256 boxMinY = _mm256_set1_ps(box.minY);
+    const __m256 boxMaxX = _mm256_set1_ps(box.maxX);
+    const __m256 boxMaxY = _mm256_set1_ps(box.maxY);
+    const float* data = &boxes[0].minX;
+
+    size_t total = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float* group = data + i * 4;
+        __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(group)), _mm_loadu_ps(group + 16), 1);
+        __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(group + 4)), _mm_loadu_ps(group + 20), 1);
+        __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(group + 8)), _mm_loadu_ps(group + 24), 1);
+        __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(group + 12)), _mm_loadu_ps(group + 28), 1);
+
+        __m256 t0 = _mm256_unpacklo_ps(r0, r1); // minX0 minX1 minY0 minY1
+        __m256 t1 = _mm256_unpackhi_ps(r0, r1); // maxX0 maxX1 maxY0 maxY1
+        __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+        __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+        __m256 minX = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 minY = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 maxX = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 maxY = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+        __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(minX, boxMaxX, _CMP_LE_OQ), _mm256_cmp_ps(maxX, boxMinX, _CMP_GE_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(minY, boxMaxY, _CMP_LE_OQ), _mm256_cmp_ps(maxY, boxMinY, _CMP_GE_OQ)));
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(hit);
+        if (mask != 0) {
+            hits[i >> 6] |= (uint64_t)mask << (i & 63);
+            total += countBits(mask);
+        }
+    }
+    return total + overlapScalar(box, boxes, i, count, hits);
+}
+
+static bool cpuHasAVX()
+{
+    // __builtin_cpu_supports já confere se o sistema salva os registradores YMM
+    static const bool supported = __builtin_cpu_supports("avx");
+    return supported;
+}
+#endif
+
+size_t overlapBatch(const AABB& box, const AABB* boxes, size_t count, uint64_t* hits)
+{
+    memset(hits, 0, ((count + 63) / 64) * sizeof(uint64_t));
+    if (count == 0) return 0;
+
+#ifdef COLLISION_AVX
+    if (cpuHasAVX()) return overlapAVX(box, boxes, count, hits);
+#endif
+#ifdef COLLISION_SSE
+    return overlapSSE(box, boxes, count, hits);
+#else
+    return overlapScalar(box, boxes, 0, count, hits);
+#endif
+}
+
+const char* overlapBatchKernel()
+{
+#ifdef COLLISION_AVX
+    if (cpuHasAVX()) return "avx";
+#endif
+#ifdef COLLISION_SSE
+    return "sse";
+#else
+    return "escalar";
+#endif
+}
@@ -0,0 +1,217 @@
+#include "FileUtils.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <filesystem>
+#include <atomic>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ===== HASH =====
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool hashFile(const string& filePath, uint64_t& outHash)
+{
+    ifstream file(filePath, ios::binary);
+    if (!file.is_open()) return false;
+
+    // Lê em blocos para não precisar carregar o arquivo inteiro
+    uint64_t hash = 14695981039346656037ULL;
+    char buffer[64 * 1024];
+    while (file)
+    {
+        file.read(buffer, sizeof(buffer));
+        hash = hashBytes(buffer, (size_t)file.gcount(), hash);
+    }
+
+    outHash = hash;
+    return true;
+}
+
+string hashToHex(uint64_t hash)
+{
+    char text[17];
+    snprintf(text, sizeof(text), "%016llx", (unsigned long long)hash);
+    return string(text);
+}
+
+// ===== ARQUIVOS =====
+
+bool readFile(const string& filePath, vector<unsigned char>& outData)
+{
+    ifstream file(filePath, ios::binary | ios::ate);
+    if (!file.is_open()) return false;
+
+    streamsize size = file.tellg();
+    file.seekg(0, ios::beg);
+    outData.resize((size_t)size);
+    if (size > 0 && !file.read((char*)outData.data(), size)) return false;
+    return true;
+}
+
+bool writeFileAtomic(const string& filePath, const void* data, size_t size)
+{
+    // Escreve num arquivo temporário e renomeia no final, assim outro processo
+    // nunca enxerga um arquivo de cache pela metade. O nome temporário é único
+    // (processo + contador) e fica no mesmo diretório, para o rename não trocar
+    // de sistema de arquivos nem colidir com outro processo gravando o mesmo arquivo
+    static atomic<unsigned long> tmpCounter(0);
+#ifdef _WIN32
+    unsigned long processId = (unsigned long)GetCurrentProcessId();
+#else
+    unsigned long processId = (unsigned long)getpid();
+#endif
+    string tmpPath = filePath + "." + to_string(processId) + "." + to_string(tmpCounter++) + ".tmp";
+    {
+        ofstream file(tmpPath, ios::binary | ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(static_cast<const char*>(data), (streamsize)size);
+        file.close();
+        if (!file)
+        {
+            error_code ec;
+            filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    error_code ec;
+    filesystem::rename(tmpPath, filePath, ec);
+    if (ec)
+    {
+        filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool createDirectories(const string& dirPath)
+{
+    error_code ec;
+    filesystem::create_directories(dirPath, ec);
+    return !ec && filesystem::is_directory(dirPath, ec);
+}
+
+// ===== ARQUIVO MAPEADO =====
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : ptr(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr)
+{
+}
+
+bool MappedFile::open(const string& filePath)
+{
+    close();
+
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    ptr = static_cast<const unsigned char*>(view);
+    length = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (ptr) UnmapViewOfFile(ptr);
+    if (mappingHandle) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle) CloseHandle((HANDLE)fileHandle);
+    ptr = nullptr;
+    length = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : ptr(nullptr), length(0)
+{
+}
+
+bool MappedFile::open(const string& filePath)
+{
+    close();
+
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // o mapeamento continua válido após fechar o descritor
+    if (view == MAP_FAILED) return false;
+
+    ptr = static_cast<const unsigned char*>(view);
+    length = (size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (ptr) munmap((void*)ptr, length);
+    ptr = nullptr;
+    length = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
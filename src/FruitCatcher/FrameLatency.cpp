@@ -0,0 +1,177 @@
+#include "FrameLatency.h"
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <chrono>
+
+// Quantas latências entram na média e no p95
+static const size_t RECENT_SAMPLES = 240;
+
+// Cercas guardadas no máximo (a sonda precisa de algumas mesmo sem limite)
+static const size_t MAX_PENDING_FRAMES = 8;
+
+static double now()
+{
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FrameLatency::FrameLatency()
+    : queueLimit(0), useFinish(false), probe(false), pendingInput(-1.0), frameInput(-1.0),
+      gpuToCpu(0.0), recentNext(0)
+{
+}
+
+void FrameLatency::initialize(int queueLimit, bool useFinish, bool probe)
+{
+    this->queueLimit = max(0, queueLimit);
+    this->useFinish = useFinish && this->queueLimit > 0;
+    this->probe = probe;
+    recent.clear();
+    recentNext = 0;
+    stats = FrameLatencyStats();
+
+    cout << "Fila de frames: " << (this->queueLimit == 0 ? string("driver")
+                                   : to_string(this->queueLimit) + (this->useFinish ? " (glFinish)" : " (cercas)"))
+         << " | sonda de latência " << (probe ? "sim" : "não") << endl;
+}
+
+void FrameLatency::destroy()
+{
+    for (PendingFrame& frame : frames) {
+        if (frame.fence != nullptr) glDeleteSync(frame.fence);
+        if (frame.query != 0) freeQueries.push_back(frame.query);
+    }
+    frames.clear();
+    if (!freeQueries.empty()) glDeleteQueries((GLsizei)freeQueries.size(), freeQueries.data());
+    freeQueries.clear();
+}
+
+void FrameLatency::onInput()
+{
+    if (pendingInput < 0.0) pendingInput = now();
+}
+
+void FrameLatency::inputSampled()
+{
+    frameInput = pendingInput;
+    pendingInput = -1.0;
+}
+
+void FrameLatency::waitForQueue()
+{
+    double start = now();
+    stats.queueWaitMs = 0.0f;
+
+    if (queueLimit > 0 && !useFinish) {
+        // Frame N só começa quando a GPU terminou o frame N - limite
+        while (frames.size() >= (size_t)queueLimit) {
+            size_t before = frames.size();
+            collect(true);
+            if (frames.size() == before) break; // não deveria acontecer
+        }
+    }
+    collect(false);
+
+    float waited = (float)((now() - start) * 1000.0);
+    if (waited > 0.05f) {
+        stats.queueWaits++;
+        stats.queueWaitMs = waited;
+    }
+}
+
+void FrameLatency::endFrame()
+{
+    bool needFence = queueLimit > 0 && !useFinish;
+    if (!needFence && !probe) {
+        if (useFinish) glFinish();
+        frameInput = -1.0;
+        return;
+    }
+
+    PendingFrame frame = { nullptr, 0, frameInput };
+    frameInput = -1.0;
+
+    if (probe) {
+        // Relógio da GPU -> CPU, recalibrado a cada frame (derivas são lentas)
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        gpuToCpu = now() - gpuNow * 1e-9;
+
+        if (frame.inputTime >= 0.0) {
+            if (freeQueries.empty()) {
+                GLuint query = 0;
+                glGenQueries(1, &query);
+                freeQueries.push_back(query);
+            }
+            frame.query = freeQueries.back();
+            freeQueries.pop_back();
+            glQueryCounter(frame.query, GL_TIMESTAMP);
+        }
+    }
+    if (needFence || frame.query != 0) {
+        frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    if (frame.fence != nullptr) {
+        frames.push_back(frame);
+    }
+
+    if (useFinish) {
+        glFinish();
+        collect(false);
+    }
+
+    // Sem limite, só a sonda guarda cercas: não deixa a lista crescer
+    while (frames.size() > MAX_PENDING_FRAMES) {
+        collect(true);
+    }
+}
+
+void FrameLatency::collect(bool wait)
+{
+    while (!frames.empty()) {
+        PendingFrame& frame = frames.front();
+        GLenum result = glClientWaitSync(frame.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                         wait ? 100000000ull : 0); // até 100 ms
+        if (result == GL_TIMEOUT_EXPIRED) return;
+        wait = false; // só o mais antigo espera; os seguintes só se já terminaram
+
+        if (frame.query != 0) {
+            GLuint64 gpuDone = 0;
+            glGetQueryObjectui64v(frame.query, GL_QUERY_RESULT, &gpuDone);
+            double done = gpuDone * 1e-9 + gpuToCpu;
+            if (done >= frame.inputTime) addSample((float)((done - frame.inputTime) * 1000.0));
+            freeQueries.push_back(frame.query);
+        }
+        glDeleteSync(frame.fence);
+        frames.pop_front();
+    }
+}
+
+void FrameLatency::addSample(float ms)
+{
+    if (recent.size() < RECENT_SAMPLES) {
+        recent.push_back(ms);
+    } else {
+        recent[recentNext] = ms;
+        recentNext = (recentNext + 1) % RECENT_SAMPLES;
+    }
+    stats.samples++;
+    stats.lastMs = ms;
+    stats.maxMs = max(stats.maxMs, ms);
+}
+
+FrameLatencyStats FrameLatency::getStats() const
+{
+    FrameLatencyStats current = stats;
+    if (!recent.empty()) {
+        vector<float> sorted = recent;
+        sort(sorted.begin(), sorted.end());
+        float sum = 0.0f;
+        for (float ms : sorted) sum += ms;
+        current.averageMs = sum / sorted.size();
+        current.p95Ms = sorted[min(sorted.size() - 1, (size_t)(sorted.size() * 0.95))];
+    }
+    return current;
+}
@@ -0,0 +1,138 @@
+#include "FramePacer.h"
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// Frames seguidos bem mais curtos que o período do monitor para concluir
+// que o vsync foi ignorado (desligado no painel do driver, por exemplo)
+static const int VSYNC_IGNORED_FRAMES = 60;
+
+static const double MIN_SPIN_MARGIN = 0.0002;
+static const double MAX_SPIN_MARGIN = 0.020; // timer de ~15,6 ms no Windows
+
+static double now()
+{
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FramePacer::FramePacer()
+    : window(nullptr), vsync(false), targetFps(0), idleFps(10), refreshPeriod(0.0),
+      nextDeadline(0.0), lastFrameEnd(0.0), spinMargin(0.002), fastSwaps(0)
+{
+}
+
+void FramePacer::initialize(GLFWwindow* window, bool vsync, int targetFps, int idleFps)
+{
+    this->window = window;
+    this->vsync = vsync;
+    this->targetFps = max(0, targetFps);
+    this->idleFps = max(1, idleFps);
+
+    glfwSwapInterval(vsync ? 1 : 0);
+
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = monitor != nullptr ? glfwGetVideoMode(monitor) : nullptr;
+    refreshPeriod = (mode != nullptr && mode->refreshRate > 0) ? 1.0 / mode->refreshRate : 0.0;
+
+    nextDeadline = now();
+    lastFrameEnd = nextDeadline;
+    stats = FramePacerStats();
+    stats.targetFps = this->targetFps;
+
+    cout << "Ritmo dos frames: vsync " << (vsync ? "sim" : "não")
+         << " | limite " << (this->targetFps > 0 ? to_string(this->targetFps) + " fps" : string("nenhum"))
+         << " | parado " << this->idleFps << " fps";
+    if (refreshPeriod > 0.0) cout << " | monitor " << (int)(1.0 / refreshPeriod + 0.5) << " Hz";
+    cout << endl;
+}
+
+double FramePacer::framePeriod() const
+{
+    if (targetFps > 0) return 1.0 / targetFps;
+    if (stats.vsyncIgnored) return refreshPeriod; // faz o papel do vsync
+    return 0.0;
+}
+
+bool FramePacer::isWindowActive() const
+{
+    if (window == nullptr) return true;
+    return glfwGetWindowAttrib(window, GLFW_FOCUSED) && !glfwGetWindowAttrib(window, GLFW_ICONIFIED);
+}
+
+void FramePacer::waitUntil(double deadline)
+{
+    double remaining = deadline - now();
+
+    // Dorme até perto do prazo; a margem cresce se o sistema acorda tarde
+    if (remaining > spinMargin) {
+        double requested = remaining - spinMargin;
+        double start = now();
+        this_thread::sleep_for(chrono::duration<double>(requested));
+        double slept = now() - start;
+        stats.sleptMs += (float)(slept * 1000.0);
+
+        double oversleep = max(0.0, slept - requested);
+        if (oversleep > spinMargin) {
+            spinMargin = oversleep;
+        } else {
+            spinMargin = spinMargin * 0.99 + oversleep * 0.01;
+        }
+        spinMargin = min(MAX_SPIN_MARGIN, max(MIN_SPIN_MARGIN, spinMargin));
+    }
+
+    // O resto girando, cedendo a CPU a cada volta
+    double spinStart = now();
+    while (now() < deadline) {
+        this_thread::yield();
+    }
+    stats.spunMs += (float)((now() - spinStart) * 1000.0);
+}
+
+void FramePacer::endFrame(bool idle)
+{
+    stats.sleptMs = 0.0f;
+    stats.spunMs = 0.0f;
+    stats.idleMs = 0.0f;
+
+    double frameEnd = now();
+
+    // Com vsync funcionando o swap leva ~1 período; bem menos que isso,
+    // seguidamente, quer dizer que o driver não espera o monitor
+    if (vsync && targetFps == 0 && refreshPeriod > 0.0 && !stats.vsyncIgnored) {
+        fastSwaps = (frameEnd - lastFrameEnd < refreshPeriod * 0.5) ? fastSwaps + 1 : 0;
+        if (fastSwaps >= VSYNC_IGNORED_FRAMES) {
+            stats.vsyncIgnored = true;
+            stats.targetFps = (int)(1.0 / refreshPeriod + 0.5);
+            cout << "Vsync ignorado pelo driver: limitando a " << stats.targetFps << " fps" << endl;
+        }
+    }
+
+    double period = framePeriod();
+    if (period > 0.0) {
+        nextDeadline += period;
+        if (frameEnd > nextDeadline) {
+            stats.lateFrames++;
+            // Muito atrasado: recomeça do agora em vez de emendar frames curtos
+            if (frameEnd - nextDeadline > period) nextDeadline = frameEnd;
+        }
+        waitUntil(nextDeadline);
+    }
+
+    if (idle) {
+        // Acorda no ritmo de IDLE_FPS ou antes, se chegar um evento
+        stats.idleFrames++;
+        double idleDeadline = lastFrameEnd + 1.0 / idleFps;
+        double start = now();
+        if (idleDeadline > start) {
+            glfwWaitEventsTimeout(idleDeadline - start);
+        }
+        stats.idleMs = (float)((now() - start) * 1000.0);
+        nextDeadline = now();
+    }
+
+    stats.spinMarginMs = (float)(spinMargin * 1000.0);
+    lastFrameEnd = now();
+}
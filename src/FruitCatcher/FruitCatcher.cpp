@@ -20,6 +20,13 @@
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
 
 using namespace std;
 
@@ -43,6 +50,21 @@ using namespace glm;
 #include "GameObject.h"
 #include "Background.h"
 #include "AudioManager.h"
+#include "AssetPack.h"
+#include "TextureCache.h"
+#include "TextureResidency.h"
+#include "GLExtensions.h"
+#include "ShaderCache.h"
+#include "StartupProfiler.h"
+#include "SpatialHash.h"
+#include "MotionBuffer.h"
+#include "PerfOverlay.h"
+#include "FramePacer.h"
+#include "FrameLatency.h"
+#include "Input.h"
+#include "Replay.h"
+#include "TripleBuffer.h"
+#include "JobSystem.h"
 
 // Protótipos de funções
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
@@ -64,6 +86,7 @@ struct GameConfig {
     map<string, string> audioPaths;
     map<string, string> spritesheetPaths;
     map<string, pair<int, int>> spritesheetDimensions; // nAnimations, nFrames
+    map<string, float> spritesheetFPS;                   // opcional (padrão 12)
 
     // Gameplay
     int maxLives = 5;
@@ -86,6 +109,55 @@ struct GameConfig {
     float bushOscillationSpeed = 1.5f;
     float bushOscillationAmount = 15.0f;
     float bushMiddleShakeSpeed = 8.0f;
+
+    // Orçamento de áudio
+    int audioMaxVoices = 6;
+    int audioMaxVoicesPerSound = 3;
+    float audioCoalesceMs = 40.0f;
+    int audioMemoryBudgetKB = 0; // 0 = sem limite
+
+    // Streaming da música
+    int musicPageSizeMs = 250;
+    int musicPageCount = 4;
+    string musicDecodePriority = "NORMAL";
+
+    // Overlay de desempenho (F3)
+    bool perfOverlay = false;
+
+    // Cache de assets pré-processados (relativo ao diretório de execução)
+    string cacheDir = "cache";
+
+    // Pacote gerado pelo fruitcatcher_cook (relativo ao diretório de execução)
+    string assetPack = "fruitcatcher.pack";
+    // Texturas decodificadas uma vez por máquina e compartilhadas entre processos
+    bool sharedAssetCache = false;
+
+    // Residência de texturas na GPU
+    int textureBudgetMB = 0;       // 0 = sem limite
+    float textureStreamMs = 4.0f;  // tempo máximo de carregamento por frame
+    bool textureDownscale = true;  // reduzir sprites ao tamanho em que aparecem na tela
+    int textureLoadThreads = 2;    // decodificações simultâneas no sistema de jobs (0 = thread principal)
+
+    // Queda das frutas e insetos calculada no vertex shader
+    bool gpuMotion = false;
+
+    // Ritmo dos frames
+    bool vsync = true;
+    int targetFps = 0;  // 0 = sem limite além do vsync
+    int idleFps = 10;   // menu, game over e janela sem foco
+
+    // Latência da entrada
+    bool lateLatch = true;        // cesta na posição do mouse lida logo antes de desenhar
+    int frameQueueLimit = 0;      // frames na fila da GPU (0 = o driver decide)
+    bool frameQueueFinish = false; // glFinish em vez de cercas
+    bool latencyProbe = false;
+
+    // Simulação em passo fixo (ticks por segundo)
+    int simTickHz = 120;
+    bool simThread = false; // simulação numa thread separada do desenho
+
+    // Workers do sistema de jobs (-1 = núcleos - 1)
+    int jobThreads = -1;
 };
 
 GameConfig config;
@@ -95,6 +167,13 @@ GameConfig config;
 #define WIDTH config.windowWidth
 #define HEIGHT config.windowHeight
 
+// Tamanho (na projeção) das frutas e insetos que caem
+const float OBJECT_SIZE = 50.0f;
+
+// Objetos por job nas passadas em lote sobre fallingObjects (abaixo disso,
+// tudo roda direto na thread que chamou)
+const size_t OBJECT_BATCH_SIZE = 256;
+
 // ========================================
 // FUNÇÃO PARA CARREGAR CONFIG.TXT
 // ========================================
@@ -231,20 +310,24 @@ bool loadConfig(const string& filename) {
             configsLoaded++;
         }
 
-        // === SPRITESHEETS ANIMADOS (formato: path|nAnimations|nFrames) ===
-        else if (key == "BEE_FLY_SPR" || key == "BIRD_FLY_SPR" || key == "BIRD2_FLY_SPR" ||
+        // === SPRITESHEETS ANIMADOS (formato: path|nAnimations|nFrames[|fps]) ===
+        else if (key == "BEE_FLY_SPR" || key == "BEE2_FLY_SPR" || key == "BIRD_FLY_SPR" || key == "BIRD2_FLY_SPR" ||
                  key == "RAT_WALK_SPR" || key == "RAT2_WALK_SPR") {
             // Dividir por '|'
             size_t pipe1 = value.find('|');
-            size_t pipe2 = value.rfind('|');
+            size_t pipe2 = pipe1 != string::npos ? value.find('|', pipe1 + 1) : string::npos;
+            size_t pipe3 = pipe2 != string::npos ? value.find('|', pipe2 + 1) : string::npos;
 
-            if (pipe1 != string::npos && pipe2 != string::npos && pipe1 != pipe2) {
+            if (pipe1 != string::npos && pipe2 != string::npos) {
                 string path = value.substr(0, pipe1);
                 int nAnimations = stoi(value.substr(pipe1 + 1, pipe2 - pipe1 - 1));
-                int nFrames = stoi(value.substr(pipe2 + 1));
+                int nFrames = stoi(value.substr(pipe2 + 1, pipe3 == string::npos ? string::npos : pipe3 - pipe2 - 1));
 
                 config.spritesheetPaths[key] = path;
-                config.spritesheetDimensions[key] = make_pair(nAnimations, nFrames);
+                config.spritesheetDimensions[key] = make_pair(max(1, nAnimations), max(1, nFrames));
+                if (pipe3 != string::npos) {
+                    config.spritesheetFPS[key] = stof(value.substr(pipe3 + 1));
+                }
                 configsLoaded++;
             }
         }
@@ -272,6 +355,10 @@ bool loadConfig(const string& filename) {
             config.texturePaths["GAME_OVER"] = value;
             configsLoaded++;
         }
+        else if (key == "FRUITS_ICON") {
+            config.texturePaths["FRUITS_ICON"] = value;
+            configsLoaded++;
+        }
 
         // === NÚMEROS ===
         else if (key.find("NUMBER_") == 0) {
@@ -362,6 +449,122 @@ bool loadConfig(const string& filename) {
             config.bushMiddleShakeSpeed = stof(value);
             configsLoaded++;
         }
+
+        // === ORÇAMENTO DE ÁUDIO ===
+        else if (key == "AUDIO_MAX_VOICES") {
+            config.audioMaxVoices = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "AUDIO_MAX_VOICES_PER_SOUND") {
+            config.audioMaxVoicesPerSound = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "AUDIO_COALESCE_MS") {
+            config.audioCoalesceMs = stof(value);
+            configsLoaded++;
+        }
+        else if (key == "AUDIO_MEMORY_BUDGET_KB") {
+            config.audioMemoryBudgetKB = stoi(value);
+            configsLoaded++;
+        }
+
+        // === STREAMING DA MÚSICA ===
+        else if (key == "MUSIC_PAGE_SIZE_MS") {
+            config.musicPageSizeMs = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "MUSIC_PAGE_COUNT") {
+            config.musicPageCount = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "MUSIC_DECODE_PRIORITY") {
+            config.musicDecodePriority = value;
+            configsLoaded++;
+        }
+
+        // === DEPURAÇÃO ===
+        else if (key == "PERF_OVERLAY") {
+            config.perfOverlay = stoi(value) != 0;
+            configsLoaded++;
+        }
+
+        // === CACHE ===
+        else if (key == "CACHE_DIR") {
+            config.cacheDir = value;
+            configsLoaded++;
+        }
+        else if (key == "ASSET_PACK") {
+            config.assetPack = value;
+            configsLoaded++;
+        }
+        else if (key == "SHARED_ASSET_CACHE") {
+            config.sharedAssetCache = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+        else if (key == "TEXTURE_BUDGET_MB") {
+            config.textureBudgetMB = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "TEXTURE_STREAM_MS") {
+            config.textureStreamMs = stof(value);
+            configsLoaded++;
+        }
+        else if (key == "TEXTURE_DOWNSCALE") {
+            config.textureDownscale = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+        else if (key == "TEXTURE_LOAD_THREADS") {
+            config.textureLoadThreads = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "GPU_MOTION") {
+            config.gpuMotion = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+
+        // === RITMO DOS FRAMES ===
+        else if (key == "VSYNC") {
+            config.vsync = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+        else if (key == "TARGET_FPS") {
+            config.targetFps = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "IDLE_FPS") {
+            config.idleFps = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "LATE_LATCH") {
+            config.lateLatch = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+        else if (key == "FRAME_QUEUE_LIMIT") {
+            config.frameQueueLimit = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "FRAME_QUEUE_FINISH") {
+            config.frameQueueFinish = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+        else if (key == "LATENCY_PROBE") {
+            config.latencyProbe = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+
+        // === SIMULAÇÃO ===
+        else if (key == "SIM_TICK_HZ") {
+            config.simTickHz = stoi(value);
+            configsLoaded++;
+        }
+        else if (key == "SIM_THREAD") {
+            config.simThread = (value == "1" || value == "true");
+            configsLoaded++;
+        }
+        else if (key == "JOB_THREADS") {
+            config.jobThreads = stoi(value);
+            configsLoaded++;
+        }
     }
 
     file.close();
@@ -381,8 +584,9 @@ struct TextureInfo {
     TextureInfo(GLuint texID, int w, int h) : id(texID), width(w), height(h) {}
 };
 
-TextureInfo loadTextureWithInfo(string filePath);
-GLuint loadTexture(string filePath);
+TextureInfo loadTextureWithInfo(string filePath, unsigned int scenes = SCENE_ALL);
+GLuint loadTexture(string filePath, unsigned int scenes = SCENE_ALL, float drawWidth = 0.0f, float drawHeight = 0.0f);
+GLuint shareTexture(GLuint texID, unsigned int scenes);
 GLuint setupBackgroundGeometry();
 GLuint setupCloudLayerGeometry();
 GLuint setupBushLeftGeometry();
@@ -392,14 +596,23 @@ void drawBackgroundLayer(GLuint shaderID, GLuint texID, float xOffset, float zDe
 void drawCloudLayer(GLuint shaderID, GLuint texID, float xPosition, float zDepth);
 void drawBushLayer(GLuint shaderID, GLuint VAO, GLuint texID, float xOffset, float zDepth);
 void spawnFallingObject();
+int runSimulation(double now);
+void publishSnapshot();
+void simulationLoop();
+void simulateTick(double tickStart, float tick);
+void startGame();
 void updateGame(float deltaTime);
-void checkCollisions();
+void clampBasketToScreen();
+void checkCollisions(float deltaTime, vec3 basketStart);
 void resetGame();
 GLuint setupHUDGeometry();
-void drawHUD(GLuint shaderID);
+void drawHUD(GLuint shaderID, int score, int lives);
 void drawHUDElement(GLuint shaderID, GLuint texID, float x, float y, float width, float height);
 void drawNumber(GLuint shaderID, int number, float x, float y, float digitSize, float spacing);
 GLuint createColoredQuadTexture(float r, float g, float b, float a);
+void printAudioMemory();
+void printTextureMemory();
+void updatePerfOverlay();
 
 
 // Shaders
@@ -410,10 +623,38 @@ layout (location = 1) in vec2 texc;
 out vec2 tex_coord;
 uniform mat4 projection;
 uniform mat4 model;
+uniform int motionSlot;           // -1: usar 'model'
+uniform float uTime;              // tempo de jogo (movimento e animação)
+uniform vec4 animation;           // início, FPS, frames por linha, largura do frame (s)
+uniform samplerBuffer motionData; // MotionBuffer: 3 texels por objeto
 void main()
 {
-    gl_Position = projection * model * vec4(position.x, position.y, position.z, 1.0);
-    tex_coord = vec2(texc.s, 1.0 - texc.t);
+    mat4 transform = model;
+    if (motionSlot >= 0)
+    {
+        vec4 motion = texelFetch(motionData, motionSlot * 3);       // x0, y0, vx, vy
+        vec4 spin = texelFetch(motionData, motionSlot * 3 + 1);     // t0, ângulo0, graus/s, z
+        vec4 size = texelFetch(motionData, motionSlot * 3 + 2);     // largura, altura, profundidade
+        float elapsed = uTime - spin.x;
+        vec2 center = motion.xy + motion.zw * elapsed;
+        float angle = radians(spin.y + spin.z * elapsed);
+        float c = cos(angle);
+        float s = sin(angle);
+        // translate * rotate(z) * scale, como em Sprite::update
+        transform = mat4(vec4(c * size.x, s * size.x, 0.0, 0.0),
+                         vec4(-s * size.y, c * size.y, 0.0, 0.0),
+                         vec4(0.0, 0.0, size.z, 0.0),
+                         vec4(center, spin.w, 1.0));
+    }
+    gl_Position = projection * transform * vec4(position.x, position.y, position.z, 1.0);
+
+    // Spritesheet: a coluna do frame atual sai do relógio, sem estado na CPU
+    tex_coord = texc;
+    if (animation.z > 1.0)
+    {
+        float frame = mod(floor((uTime - animation.x) * animation.y), animation.z);
+        tex_coord.x += frame * animation.w;
+    }
 }
 )glsl";
 
@@ -430,11 +671,26 @@ void main()
 )glsl";
 
 // Variáveis globais do jogo
-bool keys[1024];
 GameObject basket;
 vector<GameObject*> fallingObjects;
 vector<Background*> backgroundLayers; // Camadas de fundo para Parallax
 
+// Broadphase das colisões (células um pouco maiores que os objetos)
+SpatialHash collisionGrid(64.0f);
+vector<AABB> collisionBoxes;
+vector<GameObject*> collisionObjects;   // objeto de cada caixa
+vector<uint32_t> collisionCandidates;
+vector<AABB> candidateBoxes;            // caixas dos candidatos, contíguas para o teste em lote
+vector<uint64_t> candidateHits;         // um bit por candidato
+vector<vec2> collisionMotion;           // deslocamento de cada caixa no passo
+
+// Objeto pego pela cesta e o instante do contato dentro do passo (0..1)
+struct CollisionHit {
+    GameObject* object;
+    float timeOfImpact;
+};
+vector<CollisionHit> collisionHits;
+
 // Estados do jogo
 enum GameState {
     MENU,      // Tela inicial
@@ -444,13 +700,15 @@ enum GameState {
 
 GameState gameState = MENU; // Começar no menu
 
+// Texturas do jogo e áudio prontos: só então o clique no menu inicia a partida
+atomic<bool> gameplayReady(false);
+
 int score = 0;
 int lives = 3;
 int maxLives = 5; // Número máximo de vidas
 float spawnTimer = 0.0f;
 float spawnInterval = 1.5f; // Spawna objeto a cada 1.5 segundos
 float objectFallSpeed = 100.0f; // pixels por segundo
-double mouseX = 400.0; // Será inicializado com config.windowWidth / 2.0 na main
 bool useMouseControl = false;
 
 // Sistema de dificuldade progressiva
@@ -505,6 +763,7 @@ GLuint whitePixelTexID = 0;  // Textura de 1 pixel branco para desenhar formas c
 TextureInfo menuTitleInfo;   // Título do menu
 TextureInfo menuStartInfo;   // Botão "Iniciar Jogo"
 TextureInfo gameOverInfo;    // Texto "Game Over"
+GLuint fruitsIconTexID = 0;  // Ícone de frutas ao lado da pontuação final
 
 // Números para pontuação (0-9)
 vector<GLuint> numberTexIDs; // Texturas dos números 0 a 9
@@ -517,19 +776,126 @@ struct SpritesheetInfo {
     GLuint texID;
     int nAnimations;  // número de linhas
     int nFrames;      // número de colunas
+    float fps;
 };
 
 // Spritesheets de insetos animados (com fundo transparente)
 vector<SpritesheetInfo> insectSpritesheets; // Lista de spritesheets com suas dimensões
 
+// Pacote de assets pré-processados (declarado antes do áudio, que lê dele)
+AssetPack assetPack;
+
+// Texturas carregadas (compartilhadas por caminho e conteúdo)
+TextureCache textureCache;
+
+// Imagens decodificadas compartilhadas com outros processos do jogo
+SharedAssetCache sharedAssets;
+
+// Quais texturas ficam na GPU (o jogo guarda handles, não IDs da OpenGL)
+TextureResidency textureResidency;
+
+// Programas linkados guardados em disco (evita recompilar a cada execução)
+ShaderCache shaderCache;
+
+// Movimento das frutas e insetos na GPU (GPU_MOTION) e o relógio que ele usa
+MotionBuffer motionBuffer;
+float gameTime = 0.0f; // segundos de partida (só avança no estado PLAYING)
+const GLuint MOTION_TEXTURE_UNIT = 1;
+
+// Pixels do framebuffer por unidade da projeção (> 1 em telas de alta densidade)
+float texturePixelScale = 1.0f;
+
 // Sistema de áudio
 AudioManager audioManager;
 
+// Overlay de desempenho
+PerfOverlay perfOverlay;
+
+// Espera entre frames (vsync, limite de fps, repouso fora da partida)
+FramePacer framePacer;
+
+// Frames na fila da GPU e latência entrada -> frame
+FrameLatency frameLatency;
+
+// Tempo de cada fase da inicialização (até o primeiro frame)
+StartupProfiler startupProfiler;
+
+// Entrada: os callbacks só enfileiram eventos com a hora em que chegaram; a
+// simulação os consome em ticks de duração fixa
+InputQueue inputQueue;
+InputState inputState;
+vector<InputEvent> pendingInput;
+vector<TickInput> tickInput;
+double simClock = 0.0;      // fim do último tick simulado (relógio da GLFW)
+uint32_t simTick = 0;       // ticks da partida atual
+bool startRequested = false; // clique no menu/game over: começa no próximo tick
+
+// Replay (--record / --replay)
+string recordPath;
+string replayPath;
+ReplayWriter replayWriter;
+ReplayReader replayReader;
+bool replayRecorded = false; // só a primeira partida é gravada
+atomic<bool> replayFinished(false);
+int replayExitCode = 0;
+
+// Estado da partida publicado pela simulação ao fim dos ticks. O desenho só
+// lê isto, então pode rodar em outra thread sem esperar a simulação (e vice-versa)
+struct GameSnapshot {
+    GameState state = MENU;
+    float gameTime = 0.0f;
+    int score = 0;
+    int lives = 0;
+    bool useMouseControl = false;
+    SpriteSnapshot basket = {};
+    vector<ObjectSnapshot> objects;
+    float bushOscillationTime = 0.0f;
+    float bushMiddleShakeTime = 0.0f;
+    float cloudPositions[4] = {};
+};
+TripleBuffer<GameSnapshot> snapshots;
+
+// Threads de trabalho do jogo inteiro (decodificação de texturas,
+// atualização em lote dos objetos, cópias para o desenho)
+JobSystem jobSystem;
+
+// Thread da simulação (SIM_THREAD=1): entrada, updateGame e replay
+thread simThread;
+atomic<bool> simRunning(false);
+
 // Função MAIN
-int main()
+int main(int argc, char **argv)
 {
+    startupProfiler.start();
     srand(time(NULL));
 
+    // --startup-bench N: mede N inicializações completas em processos novos
+    // --startup-run: usado pelo benchmark, fecha após o primeiro frame
+    int startupBenchRuns = 0;
+    bool startupRun = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--startup-bench" && i + 1 < argc)
+        {
+            startupBenchRuns = atoi(argv[++i]);
+        }
+        else if (arg == "--startup-run")
+        {
+            startupRun = true;
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replayPath = argv[++i];
+        }
+    }
+
+    startupProfiler.beginPhase("config");
+
     // ========================================
     // CARREGAR ARQUIVO DE CONFIGURAÇÃO
     // ========================================
@@ -559,7 +925,43 @@ int main()
     bushOscillationAmount = config.bushOscillationAmount;
     bushMiddleShakeSpeed = config.bushMiddleShakeSpeed;
 
+    // O replay roda com o passo e o modo de movimento com que foi gravado
+    if (!replayPath.empty())
+    {
+        if (!replayReader.load(replayPath))
+        {
+            return 1;
+        }
+        config.simTickHz = (int)replayReader.getHeader().tickRate;
+        config.gpuMotion = replayReader.getHeader().gpuMotion != 0;
+        recordPath.clear();
+    }
+    if (config.simTickHz <= 0) config.simTickHz = 120;
+
+    string startupReportPath = config.cacheDir + "/startup";
+    if (startupBenchRuns != 0)
+    {
+        return runStartupBenchmark(argv[0], startupBenchRuns, startupReportPath);
+    }
+
+    // Pacote de assets: um único arquivo mapeado no lugar de dezenas de
+    // decodificações (gerado com fruitcatcher_cook)
+    startupProfiler.beginPhase("asset_pack");
+    if (!assetPack.open(config.assetPack))
+    {
+        cout << "Pacote de assets não encontrado (" << config.assetPack << "), usando os arquivos originais" << endl;
+    }
+    textureCache.setAssetPack(&assetPack);
+
+    // Várias instâncias na mesma máquina: só a primeira decodifica
+    if (config.sharedAssetCache)
+    {
+        sharedAssets.open(assetPack.isOpen() ? assetPack.getContentHash() : 0);
+        textureCache.setSharedCache(&sharedAssets);
+    }
+
     // Inicialização da GLFW
+    startupProfiler.beginPhase("janela");
     glfwInit();
 
     // Criação da janela GLFW (usando configurações do arquivo)
@@ -576,6 +978,10 @@ int main()
         return -1;
     }
     glfwMakeContextCurrent(window);
+    framePacer.initialize(window, config.vsync, config.targetFps, config.idleFps);
+
+    // Overlay de desempenho (F3 liga/desliga)
+    perfOverlay.initialize(window, config.windowTitle, config.perfOverlay);
 
     // Callbacks
     glfwSetKeyCallback(window, key_callback);
@@ -583,11 +989,18 @@ int main()
     glfwSetMouseButtonCallback(window, mouse_button_callback);
 
     // GLAD: carrega os ponteiros de funções da OpenGL
+    startupProfiler.beginPhase("opengl");
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
     {
         cerr << "Falha ao inicializar GLAD" << endl;
         return -1;
     }
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+
+    // Sprites são reduzidos para o tamanho em que aparecem no framebuffer
+    int framebufferWidth, framebufferHeight;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    texturePixelScale = std::max((float)framebufferWidth / WIDTH, (float)framebufferHeight / HEIGHT);
 
     // Informações de versão
     const GLubyte *renderer = glGetString(GL_RENDERER);
@@ -595,52 +1008,67 @@ int main()
     cout << "Renderer: " << renderer << endl;
     cout << "OpenGL version: " << version << endl;
 
-    // Inicializar array de teclas
-    for (int i = 0; i < 1024; i++)
-    {
-        keys[i] = false;
-    }
+    // Texturas são declaradas por cena e carregadas sob demanda
+    textureResidency.initialize(&textureCache, &assetPack);
+    textureResidency.setBudget((size_t)config.textureBudgetMB * 1024 * 1024);
+    textureResidency.setStreamTimePerFrame(config.textureStreamMs);
+    jobSystem.initialize(config.jobThreads);
+    textureResidency.setLoaderThreads(config.textureLoadThreads, &jobSystem);
+
+    inputState.reset(WIDTH / 2.0f);
 
     // Compilar shaders
+    startupProfiler.beginPhase("shaders");
+    shaderCache.setDirectory(config.cacheDir + "/shaders");
     GLuint shaderID = setupShader();
 
     // ========================================
-    // INICIALIZAR SISTEMA DE ÁUDIO
+    // INICIALIZAR SISTEMA DE ÁUDIO (EM SEGUNDO PLANO)
     // ========================================
-    cout << "\n=== INICIALIZANDO SISTEMA DE ÁUDIO ===" << endl;
-    if (audioManager.initialize()) {
-        // Carregar música de fundo
-        if (audioManager.loadMusic("../assets/audio/musica_fundo.mp3")) {
-            audioManager.setMusicVolume(0.5f); // Volume em 50%
-            audioManager.playMusic(true); // Tocar em loop
-            cout << "Música de fundo tocando!" << endl;
-        } else {
-            cout << "Aviso: Não foi possível carregar a música de fundo." << endl;
-        }
-
-        // Carregar efeitos sonoros
-        cout << "\nCarregando efeitos sonoros:" << endl;
-        audioManager.loadSound("fruit_collect", "../assets/audio/fruit_collect.mp3");
-        audioManager.loadSound("bug_collect", "../assets/audio/bug_collect.mp3");
-    } else {
-        cout << "Aviso: Sistema de áudio não inicializado." << endl;
-    }
+    // Enumerar dispositivos e decodificar pode levar centenas de ms; o jogo
+    // segue carregando texturas e os sons ficam disponíveis quando prontos
+    startupProfiler.beginPhase("audio");
+    cout << "\n=== INICIALIZANDO SISTEMA DE ÁUDIO (em segundo plano) ===" << endl;
+    audioManager.setCacheDirectory(config.cacheDir + "/audio");
+    audioManager.setAssetPack(&assetPack);
+
+    AudioBudget audioBudget;
+    audioBudget.maxTotalVoices = config.audioMaxVoices;
+    audioBudget.maxVoicesPerSound = config.audioMaxVoicesPerSound;
+    audioBudget.coalesceWindowMs = config.audioCoalesceMs;
+    audioManager.setBudget(audioBudget);
+    audioManager.setMemoryBudget((size_t)config.audioMemoryBudgetKB * 1024);
+
+    MusicStreamConfig streamConfig;
+    streamConfig.pageSizeMs = config.musicPageSizeMs;
+    streamConfig.pageCount = config.musicPageCount;
+    streamConfig.decodePriority = parseThreadPriority(config.musicDecodePriority);
+    audioManager.setStreamConfig(streamConfig);
+
+    vector<SoundRequest> soundEffects = {
+        {"fruit_collect", "../assets/audio/fruit_collect.mp3", 0},
+        {"bug_collect", "../assets/audio/bug_collect.mp3", 1} // perder vida tem prioridade
+    };
+    shared_future<bool> audioReady = audioManager.initializeAsync(
+        "../assets/audio/musica_fundo.mp3", 0.5f, soundEffects); // Volume em 50%
+    bool audioReadyLogged = false;
     cout << "======================================\n" << endl;
 
     // Carregar texturas de background (Parallax) - NOVA CONFIGURAÇÃO
+    startupProfiler.beginPhase("texturas");
     // Layer 1: Fundo completo com céu (estático)
-    GLuint bgTex1 = loadTexture("../kenney_background-elements-redux/Backgrounds/backgroundColorGrass.png");
+    GLuint bgTex1 = loadTexture("../kenney_background-elements-redux/Backgrounds/backgroundColorGrass.png", SCENE_ALL);
 
     // Layer 2: Nuvens individuais (movimento com bounce)
-    GLuint cloudTex1 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud1.png");
-    GLuint cloudTex2 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud2.png");
-    GLuint cloudTex3 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud3.png");
-    GLuint cloudTex4 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud4.png");
+    GLuint cloudTex1 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud1.png", SCENE_ALL);
+    GLuint cloudTex2 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud2.png", SCENE_ALL);
+    GLuint cloudTex3 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud3.png", SCENE_ALL);
+    GLuint cloudTex4 = loadTexture("../kenney_background-elements-redux/PNG/Default/cloud4.png", SCENE_ALL);
 
     // Layer 3: Bushes com movimento oscilatório e tremor
-    GLuint bushLeftTex = loadTexture("../kenney_background-elements-redux/PNG/Default/bushAlt2.png");
-    GLuint bushMiddleTex = loadTexture("../kenney_background-elements-redux/PNG/Default/bushAlt1.png");
-    GLuint bushRightTex = loadTexture("../kenney_background-elements-redux/PNG/Default/bushAlt3.png");
+    GLuint bushLeftTex = loadTexture("../kenney_background-elements-redux/PNG/Default/bushAlt2.png", SCENE_ALL);
+    GLuint bushMiddleTex = loadTexture("../kenney_background-elements-redux/PNG/Default/bushAlt1.png", SCENE_ALL);
+    GLuint bushRightTex = loadTexture("../kenney_background-elements-redux/PNG/Default/bushAlt3.png", SCENE_ALL);
 
     if (bgTex1 > 0) backgroundTexIDs.push_back(bgTex1);
     if (cloudTex1 > 0) backgroundTexIDs.push_back(cloudTex1);
@@ -662,13 +1090,13 @@ int main()
     cout << "Layer 3 (Bush Direita): " << (bushRightTex > 0 ? "OK" : "ERRO") << endl;
 
     // Carregar cesta
-    basketTexID = loadTexture("../assets/sprites/fruitcatcher/ui/basket.png");
+    basketTexID = loadTexture("../assets/sprites/fruitcatcher/ui/basket.png", SCENE_PLAYING, 80.0f, 60.0f);
 
     // Carregar TODAS as frutas disponíveis
-    GLuint appleTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/apple.png");
-    GLuint bananaTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/banana.png");
-    GLuint orangeTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/orange.png");
-    GLuint pineappleTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/pineapple.png");
+    GLuint appleTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/apple.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
+    GLuint bananaTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/banana.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
+    GLuint orangeTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/orange.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
+    GLuint pineappleTexID = loadTexture("../assets/sprites/fruitcatcher/fruits/pineapple.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
 
     if (appleTexID > 0) fruitTexIDs.push_back(appleTexID);
     if (bananaTexID > 0) fruitTexIDs.push_back(bananaTexID);
@@ -676,9 +1104,9 @@ int main()
     if (pineappleTexID > 0) fruitTexIDs.push_back(pineappleTexID);
 
     // Carregar TODOS os insetos disponíveis
-    GLuint beeTexID = loadTexture("../assets/sprites/fruitcatcher/insects/bee.png");
-    GLuint flyTexID = loadTexture("../assets/sprites/fruitcatcher/insects/fly.png");
-    GLuint ladybugTexID = loadTexture("../assets/sprites/fruitcatcher/insects/ladybug.png");
+    GLuint beeTexID = loadTexture("../assets/sprites/fruitcatcher/insects/bee.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
+    GLuint flyTexID = loadTexture("../assets/sprites/fruitcatcher/insects/fly.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
+    GLuint ladybugTexID = loadTexture("../assets/sprites/fruitcatcher/insects/ladybug.png", SCENE_PLAYING, OBJECT_SIZE, OBJECT_SIZE);
 
     if (beeTexID > 0) insectTexIDs.push_back(beeTexID);
     if (flyTexID > 0) insectTexIDs.push_back(flyTexID);
@@ -690,46 +1118,44 @@ int main()
     // ========================================
     cout << "\n=== CARREGANDO SPRITES ANIMADOS ===" << endl;
 
-    // Abelhas voando (bee_fly_spr) - 1 linha, 6 frames
-    GLuint beeFlyTexID = loadTexture("../assets/sprites/fruitcatcher/animated_sprites/bee_fly_spr.png");
-    if (beeFlyTexID > 0) {
-        insectSpritesheets.push_back({beeFlyTexID, 1, 6});
-        cout << "  - Abelha voando: OK (1x6)" << endl;
-    }
-
-    // Abelhas 2 voando (bee2_fly_spr) - 1 linha, 6 frames
-    GLuint bee2FlyTexID = loadTexture("../assets/sprites/fruitcatcher/animated_sprites/bee2_fly_spr.png");
-    if (bee2FlyTexID > 0) {
-        insectSpritesheets.push_back({bee2FlyTexID, 1, 6});
-        cout << "  - Abelha 2 voando: OK (1x6)" << endl;
-    }
-
-    // Pássaro 1 voando (bird_fly_spr) - 1 linha, 6 frames
-    GLuint birdFlyTexID = loadTexture("../assets/sprites/fruitcatcher/animated_sprites/bird_fly_spr.png");
-    if (birdFlyTexID > 0) {
-        insectSpritesheets.push_back({birdFlyTexID, 1, 6});
-        cout << "  - Pássaro 1 voando: OK (1x6)" << endl;
-    }
-
-    // Pássaro 2 voando (bird2_fly_spr) - 1 linha, 6 frames
-    GLuint bird2FlyTexID = loadTexture("../assets/sprites/fruitcatcher/animated_sprites/bird2_fly_spr.png");
-    if (bird2FlyTexID > 0) {
-        insectSpritesheets.push_back({bird2FlyTexID, 1, 6});
-        cout << "  - Pássaro 2 voando: OK (1x6)" << endl;
-    }
-
-    // Rato 1 andando (rat_walk_spr) - 1 linha, 4 frames
-    GLuint ratWalkTexID = loadTexture("../assets/sprites/fruitcatcher/animated_sprites/rat_walk_spr.png");
-    if (ratWalkTexID > 0) {
-        insectSpritesheets.push_back({ratWalkTexID, 1, 4});
-        cout << "  - Rato 1 andando: OK (1x4)" << endl;
-    }
+    // Grade e FPS vêm do config.txt (BEE_FLY_SPR=...|1|6[|fps]); os valores
+    // abaixo valem se a chave faltar
+    struct AnimatedSpriteSource {
+        const char* key;
+        const char* path;
+        const char* label;
+        int nAnimations;
+        int nFrames;
+    };
+    const AnimatedSpriteSource animatedSources[] = {
+        {"BEE_FLY_SPR", "../assets/sprites/fruitcatcher/animated_sprites/bee_fly_spr.png", "Abelha voando", 1, 6},
+        {"BEE2_FLY_SPR", "../assets/sprites/fruitcatcher/animated_sprites/bee2_fly_spr.png", "Abelha 2 voando", 1, 6},
+        {"BIRD_FLY_SPR", "../assets/sprites/fruitcatcher/animated_sprites/bird_fly_spr.png", "Pássaro 1 voando", 1, 6},
+        {"BIRD2_FLY_SPR", "../assets/sprites/fruitcatcher/animated_sprites/bird2_fly_spr.png", "Pássaro 2 voando", 1, 6},
+        {"RAT_WALK_SPR", "../assets/sprites/fruitcatcher/animated_sprites/rat_walk_spr.png", "Rato 1 andando", 1, 4},
+        {"RAT2_WALK_SPR", "../assets/sprites/fruitcatcher/animated_sprites/rat2_walk_spr.png", "Rato 2 andando", 1, 4},
+    };
+    for (const AnimatedSpriteSource& source : animatedSources)
+    {
+        SpritesheetInfo info = {0, source.nAnimations, source.nFrames, 12.0f};
+        auto dimensions = config.spritesheetDimensions.find(source.key);
+        if (dimensions != config.spritesheetDimensions.end())
+        {
+            info.nAnimations = dimensions->second.first;
+            info.nFrames = dimensions->second.second;
+        }
+        auto fps = config.spritesheetFPS.find(source.key);
+        if (fps != config.spritesheetFPS.end() && fps->second > 0.0f)
+        {
+            info.fps = fps->second;
+        }
 
-    // Rato 2 andando (rat2_walk_spr) - 1 linha, 4 frames
-    GLuint rat2WalkTexID = loadTexture("../assets/sprites/fruitcatcher/animated_sprites/rat2_walk_spr.png");
-    if (rat2WalkTexID > 0) {
-        insectSpritesheets.push_back({rat2WalkTexID, 1, 4});
-        cout << "  - Rato 2 andando: OK (1x4)" << endl;
+        info.texID = loadTexture(source.path, SCENE_PLAYING, info.nFrames * OBJECT_SIZE, info.nAnimations * OBJECT_SIZE);
+        if (info.texID > 0) {
+            insectSpritesheets.push_back(info);
+            cout << "  - " << source.label << ": OK (" << info.nAnimations << "x" << info.nFrames
+                 << ", " << info.fps << " fps)" << endl;
+        }
     }
 
     cout << "Total de sprites animados: " << insectSpritesheets.size() << endl;
@@ -741,16 +1167,16 @@ int main()
     cout << "Backgrounds carregados: " << backgroundTexIDs.size() << endl;
 
     // Carregar texturas do HUD (corações)
-    heartFullTexID = loadTexture("../assets/sprites/fruitcatcher/ui/heart_full.png");
-    heartEmptyTexID = loadTexture("../assets/sprites/fruitcatcher/ui/heart_empty.png");
+    heartFullTexID = loadTexture("../assets/sprites/fruitcatcher/ui/heart_full.png", SCENE_PLAYING, 30.0f, 30.0f);
+    heartEmptyTexID = loadTexture("../assets/sprites/fruitcatcher/ui/heart_empty.png", SCENE_PLAYING, 30.0f, 30.0f);
 
     // Se não encontrar os corações, usar frutas como placeholder
     if (heartFullTexID == 0 && !fruitTexIDs.empty()) {
-        heartFullTexID = fruitTexIDs[0];
+        heartFullTexID = shareTexture(fruitTexIDs[0], SCENE_PLAYING);
         cout << "Aviso: Usando fruta como coração cheio (adicione heart_full.png)" << endl;
     }
     if (heartEmptyTexID == 0 && !insectTexIDs.empty()) {
-        heartEmptyTexID = insectTexIDs[0];
+        heartEmptyTexID = shareTexture(insectTexIDs[0], SCENE_PLAYING);
         cout << "Aviso: Usando inseto como coração vazio (adicione heart_empty.png)" << endl;
     }
 
@@ -761,9 +1187,9 @@ int main()
     blackTexID = createColoredQuadTexture(0.0f, 0.0f, 0.0f, 0.8f);
 
     // Carregar texturas das telas do menu e game over
-    menuTitleInfo = loadTextureWithInfo("../assets/sprites/fruitcatcher/ui/menu_title.png");
-    menuStartInfo = loadTextureWithInfo("../assets/sprites/fruitcatcher/ui/menu_start.png");
-    gameOverInfo = loadTextureWithInfo("../assets/sprites/fruitcatcher/ui/game_over.png");
+    menuTitleInfo = loadTextureWithInfo("../assets/sprites/fruitcatcher/ui/menu_title.png", SCENE_MENU);
+    menuStartInfo = loadTextureWithInfo("../assets/sprites/fruitcatcher/ui/menu_start.png", SCENE_MENU | SCENE_GAME_OVER);
+    gameOverInfo = loadTextureWithInfo("../assets/sprites/fruitcatcher/ui/game_over.png", SCENE_GAME_OVER);
 
     cout << "\nTelas do jogo:" << endl;
     cout << "  - Menu Title: " << (menuTitleInfo.id > 0 ? "OK" : "FALTANDO") << " (" << menuTitleInfo.width << "x" << menuTitleInfo.height << ")" << endl;
@@ -776,12 +1202,27 @@ int main()
     for (int i = 0; i < 10; i++)
     {
         string path = "../assets/sprites/fruitcatcher/numbers/" + numberNames[i] + ".png";
-        GLuint numTex = loadTexture(path);
+        GLuint numTex = loadTexture(path, SCENE_PLAYING | SCENE_GAME_OVER);
         numberTexIDs.push_back(numTex);
         cout << "  - Número " << i << ": " << (numTex > 0 ? "OK" : "FALTANDO") << endl;
     }
 
+    // Ícone de frutas da tela de game over (carregado aqui, não no render loop)
+    fruitsIconTexID = loadTexture("../assets/sprites/fruitcatcher/ui/fruits.png", SCENE_GAME_OVER);
+    if (fruitsIconTexID == 0 && !fruitTexIDs.empty())
+    {
+        fruitsIconTexID = shareTexture(fruitTexIDs[0], SCENE_GAME_OVER); // Fallback
+    }
+
+    printTextureMemory();
+
+    // Só o menu é carregado antes do primeiro frame; as texturas do jogo
+    // continuam sendo decodificadas nas threads enquanto ele aparece
+    startupProfiler.beginPhase("texturas_menu");
+    textureResidency.loadSceneNow(SCENE_MENU);
+
     // Inicializar a cesta
+    startupProfiler.beginPhase("geometria");
     basket.initialize(shaderID, basketTexID, vec3(WIDTH / 2.0f, 50.0f, 0.0f), vec3(80.0f, 60.0f, 1.0f));
     basket.setType(OBJ_BASKET);
 
@@ -800,7 +1241,7 @@ int main()
     // Configurações OpenGL
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); // texturas com alfa pré-multiplicado
 
     glUseProgram(shaderID);
 
@@ -812,31 +1253,97 @@ int main()
     glActiveTexture(GL_TEXTURE0);
     glUniform1i(glGetUniformLocation(shaderID, "tex_buffer"), 0);
 
+    // Movimento na GPU: só frutas e insetos usam um slot; o resto desenha com 'model'
+    glUniform1i(glGetUniformLocation(shaderID, "motionSlot"), -1);
+    glUniform1i(glGetUniformLocation(shaderID, "motionData"), MOTION_TEXTURE_UNIT);
+    if (config.gpuMotion)
+    {
+        if (motionBuffer.initialize(256))
+        {
+            motionBuffer.bind(MOTION_TEXTURE_UNIT);
+        }
+        else
+        {
+            config.gpuMotion = false;
+        }
+    }
+    frameLatency.initialize(config.frameQueueLimit, config.frameQueueFinish, config.latencyProbe);
+    cout << "Movimento dos objetos: " << (config.gpuMotion ? "GPU (posição calculada no shader)" : "CPU") << endl;
+    cout << "Simulação: " << config.simTickHz << " ticks/s" << endl;
+
     // Variáveis de tempo
     float lastFrame = glfwGetTime();
     float deltaTime = 0.0f;
+    simClock = lastFrame;
 
     cout << "\n=== FRUIT CATCHER ===" << endl;
     cout << "Controles:" << endl;
     cout << "  - Setas Esquerda/Direita ou A/D: Mover cesta" << endl;
     cout << "  - Mouse: Mover cesta seguindo cursor" << endl;
+    cout << "  - F3: Overlay de desempenho" << endl;
     cout << "  - ESC: Sair" << endl;
     cout << "Objetivo: Colete frutas e evite insetos!" << endl;
     cout << "=====================\n" << endl;
 
+    // A partir daqui o estado do jogo é da simulação; o loop abaixo desenha
+    // a última cópia publicada
+    publishSnapshot();
+    if (config.simThread)
+    {
+        simRunning = true;
+        simThread = thread(simulationLoop);
+    }
+    cout << "Simulação: " << (config.simThread ? "thread própria" : "junto do desenho") << endl;
+
+    // O primeiro frame também carrega as texturas da cena inicial
+    startupProfiler.beginPhase("primeiro_frame");
+
     // Game loop
     while (!glfwWindowShouldClose(window))
     {
+        // Não deixa a CPU abrir mais frames de vantagem que FRAME_QUEUE_LIMIT
+        frameLatency.waitForQueue();
+
         // Calcular deltaTime
         float currentFrame = glfwGetTime();
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
+        perfOverlay.frame(deltaTime);
+
+        // Carregar/remover texturas conforme a cena atual (a do último estado desenhado)
+        GameState sceneState = snapshots.readBuffer().state;
+        textureResidency.beginFrame(sceneState == MENU ? SCENE_MENU : sceneState == PLAYING ? SCENE_PLAYING : SCENE_GAME_OVER);
+
+        // Libera o início da partida quando o que ela usa terminou de carregar
+        if (!gameplayReady && audioReady.wait_for(chrono::seconds(0)) == future_status::ready &&
+            textureResidency.isSceneReady(SCENE_PLAYING))
+        {
+            gameplayReady = true;
+            cout << "Jogo pronto para começar (" << glfwGetTime() << " s após iniciar a GLFW)" << endl;
+        }
+
+        // Primeiro processo: publica as imagens decodificadas quando todas carregaram
+        if (sharedAssets.isRecording() && textureResidency.isSceneReady(SCENE_ALL))
+        {
+            sharedAssets.publish();
+        }
 
         // Processar eventos
         glfwPollEvents();
 
-        // Atualizar jogo
-        updateGame(deltaTime);
+        // Sem a thread da simulação, os ticks rodam aqui, antes do desenho
+        if (!config.simThread && runSimulation(glfwGetTime()) > 0)
+        {
+            publishSnapshot();
+        }
+        if (replayFinished)
+        {
+            glfwSetWindowShouldClose(window, GL_TRUE);
+        }
+
+        // Estado mais recente publicado pela simulação
+        snapshots.acquire();
+        const GameSnapshot& view = snapshots.readBuffer();
 
         // Limpar tela
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -859,23 +1366,23 @@ int main()
         // Layer 2 (Clouds) - Múltiplas nuvens com bounce nos limites da tela
         if (backgroundTexIDs.size() >= 5) {
             // Desenhar 4 nuvens em posições diferentes com bounce
-            drawCloudLayer(shaderID, backgroundTexIDs[1], cloudPositions[0], -0.4f);
-            drawCloudLayer(shaderID, backgroundTexIDs[2], cloudPositions[1], -0.4f);
-            drawCloudLayer(shaderID, backgroundTexIDs[3], cloudPositions[2], -0.4f);
-            drawCloudLayer(shaderID, backgroundTexIDs[4], cloudPositions[3], -0.4f);
+            drawCloudLayer(shaderID, backgroundTexIDs[1], view.cloudPositions[0], -0.4f);
+            drawCloudLayer(shaderID, backgroundTexIDs[2], view.cloudPositions[1], -0.4f);
+            drawCloudLayer(shaderID, backgroundTexIDs[3], view.cloudPositions[2], -0.4f);
+            drawCloudLayer(shaderID, backgroundTexIDs[4], view.cloudPositions[3], -0.4f);
         }
 
         // Layer 3 (Bushes) - Movimento oscilatório e tremor (frente)
         if (backgroundTexIDs.size() >= 8) {
             // Calcular offset oscilatório para as bushes laterais
-            float bushOffset = sin(bushOscillationTime) * bushOscillationAmount;
+            float bushOffset = sin(view.bushOscillationTime) * bushOscillationAmount;
 
             // Bush esquerda - movimento para direita/esquerda
             drawBushLayer(shaderID, bushLeftVAO, backgroundTexIDs[5], bushOffset, -0.3f);
 
             // Bush central - tremor rápido e sutil
-            float shakeX = sin(bushMiddleShakeTime) * bushMiddleShakeAmount;
-            float shakeY = cos(bushMiddleShakeTime * 1.3f) * bushMiddleShakeAmount * 0.5f; // Tremor também em Y
+            float shakeX = sin(view.bushMiddleShakeTime) * bushMiddleShakeAmount;
+            float shakeY = cos(view.bushMiddleShakeTime * 1.3f) * bushMiddleShakeAmount * 0.5f; // Tremor também em Y
             drawBushLayer(shaderID, bushMiddleVAO, backgroundTexIDs[6], shakeX, -0.3f);
 
             // Bush direita - movimento oposto (para criar efeito de balanço)
@@ -884,8 +1391,21 @@ int main()
 
         glEnable(GL_DEPTH_TEST);
 
+        // Late latch: a cesta é desenhada no cursor lido agora, logo antes do
+        // mundo, e não no do último tick. Só no desenho: a simulação continua
+        // com a posição do tick (e o replay não depende do cursor)
+        SpriteSnapshot basketView = view.basket;
+        if (view.state == PLAYING && config.lateLatch && view.useMouseControl && replayPath.empty())
+        {
+            double cursorX, cursorY;
+            glfwGetCursorPos(window, &cursorX, &cursorY);
+            float halfWidth = basketView.dimensions.x / 2.0f;
+            basketView.pos.x = std::min(std::max((float)cursorX, halfWidth), WIDTH - halfWidth);
+        }
+        frameLatency.inputSampled();
+
         // Desenhar baseado no estado do jogo
-        if (gameState == MENU)
+        if (view.state == MENU)
         {
             // TELA DE MENU
             glDisable(GL_DEPTH_TEST);
@@ -901,8 +1421,8 @@ int main()
                 drawHUDElement(shaderID, menuTitleInfo.id, x, y, w, h);
             }
 
-            // Desenhar botão Start (centralizado)
-            if (menuStartInfo.id > 0 && menuStartInfo.width > 0)
+            // Desenhar botão Start (centralizado) quando o jogo puder começar
+            if (gameplayReady && menuStartInfo.id > 0 && menuStartInfo.width > 0)
             {
                 float w = menuStartInfo.width;
                 float h = menuStartInfo.height;
@@ -913,25 +1433,34 @@ int main()
 
             glEnable(GL_DEPTH_TEST);
         }
-        else if (gameState == PLAYING)
+        else if (view.state == PLAYING)
         {
             // JOGANDO - Desenhar objetos do jogo
-            basket.update();
-            basket.draw();
+            // Um único relógio para o movimento e a animação de todos os sprites
+            glUniform1f(glGetUniformLocation(shaderID, "uTime"), view.gameTime);
+
+            Sprite::drawSnapshot(shaderID, basketView);
 
-            for (auto obj : fallingObjects)
+            for (const ObjectSnapshot& object : view.objects)
             {
-                if (obj->isActive)
+                if (!object.sprite.isActive) continue;
+
+                // O slot só sobe para a GPU quando muda (no spawn)
+                int motionSlot = object.motionSlot;
+                if (motionSlot >= 0 && !motionBuffer.write(motionSlot, object.motion))
                 {
-                    obj->update();
-                    obj->draw();
+                    motionSlot = -1;
                 }
+                Sprite::drawSnapshot(shaderID, object.sprite, motionSlot);
             }
+            // Fundo e HUD desenham com 'model' e sem animação
+            glUniform1i(glGetUniformLocation(shaderID, "motionSlot"), -1);
+            glUniform4f(glGetUniformLocation(shaderID, "animation"), 0.0f, 0.0f, 0.0f, 0.0f);
 
             // Desenhar HUD
-            drawHUD(shaderID);
+            drawHUD(shaderID, view.score, view.lives);
         }
-        else if (gameState == GAME_OVER)
+        else if (view.state == GAME_OVER)
         {
             // TELA DE GAME OVER
             glDisable(GL_DEPTH_TEST);
@@ -953,7 +1482,7 @@ int main()
             if (!numberTexIDs.empty() && numberTexIDs[0] > 0)
             {
                 // Calcular largura total do número para centralizar
-                string scoreStr = to_string(score);
+                string scoreStr = to_string(view.score);
                 float digitSize = 50.0f; // Números grandes
                 float spacing = 10.0f;
                 float iconSize = 50.0f; // Tamanho do ícone de frutas
@@ -970,28 +1499,14 @@ int main()
                 float startX = (WIDTH - totalWidth) / 2.0f;
 
                 // Desenhar ícone de frutas à esquerda
-                if (!fruitTexIDs.empty())
+                if (fruitsIconTexID > 0)
                 {
-                    // Tentar carregar fruits.png se ainda não carregamos
-                    static GLuint fruitsIconTexID = 0;
-                    if (fruitsIconTexID == 0)
-                    {
-                        fruitsIconTexID = loadTexture("../assets/sprites/fruitcatcher/ui/fruits.png");
-                        if (fruitsIconTexID == 0 && !fruitTexIDs.empty())
-                        {
-                            fruitsIconTexID = fruitTexIDs[0]; // Fallback
-                        }
-                    }
-
-                    if (fruitsIconTexID > 0)
-                    {
-                        drawHUDElement(shaderID, fruitsIconTexID, startX, scoreY, iconSize, iconSize);
-                    }
+                    drawHUDElement(shaderID, fruitsIconTexID, startX, scoreY, iconSize, iconSize);
                 }
 
                 // Desenhar números à direita do ícone
                 float numbersX = startX + iconSize + iconSpacing;
-                drawNumber(shaderID, score, numbersX, scoreY, digitSize, spacing);
+                drawNumber(shaderID, view.score, numbersX, scoreY, digitSize, spacing);
             }
 
             // Desenhar botão Start novamente (centralizado, mais abaixo)
@@ -1009,8 +1524,79 @@ int main()
 
         // Swap buffers
         glfwSwapBuffers(window);
+        frameLatency.endFrame();
+
+        // Primeiro frame apresentado: fecha a medição da inicialização
+        if (!startupProfiler.isFinished())
+        {
+            glFinish(); // garante que o frame saiu da GPU, não só da fila
+            startupProfiler.finish();
+            startupProfiler.writeReport(startupReportPath);
+            if (startupRun)
+            {
+                startupProfiler.appendRun(startupReportPath + "_runs.tsv");
+                glfwSetWindowShouldClose(window, GL_TRUE);
+            }
+        }
+
+        // Métricas do mixer de áudio deste frame
+        audioManager.endFrame();
+        if (perfOverlay.isEnabled())
+        {
+            updatePerfOverlay();
+        }
+        perfOverlay.update();
+
+        // Fora da partida (ou sem foco) nada se mexe: espera eventos em vez de
+        // redesenhar, desde que não haja texturas chegando
+        bool idle = (view.state != PLAYING || !framePacer.isWindowActive()) && gameplayReady &&
+                    textureResidency.getStats().decoding == 0;
+        framePacer.endFrame(idle);
+
+        // Avisar (uma vez) quando o áudio terminar de subir em segundo plano
+        if (!audioReadyLogged && audioReady.wait_for(chrono::seconds(0)) == future_status::ready)
+        {
+            if (audioReady.get()) printAudioMemory();
+            audioReadyLogged = true;
+        }
+    }
+
+    simRunning = false;
+    if (simThread.joinable())
+    {
+        simThread.join();
+    }
+
+    // Janela fechada no meio da partida: o replay termina aqui
+    if (replayWriter.isRecording())
+    {
+        replayWriter.finish(recordPath, simTick, score, lives);
+    }
+    if (inputQueue.getDropped() > 0)
+    {
+        cout << "Entrada: " << inputQueue.getDropped() << " eventos descartados (fila cheia)" << endl;
     }
 
+    AudioStats audioStats = audioManager.getStats();
+    cout << "\n=== ESTATÍSTICAS DE ÁUDIO ===" << endl;
+    cout << "Pico de vozes simultâneas: " << audioStats.peakVoices << endl;
+    cout << "Disparos coalescidos: " << audioStats.coalescedTriggers
+         << " | vozes reaproveitadas: " << audioStats.stolenVoices
+         << " | descartados: " << audioStats.culledTriggers << endl;
+    cout << "Mixagem: pico " << audioStats.peakMixTimeMs << " ms/frame" << endl;
+    if (audioManager.isMusicStreamed())
+    {
+        MusicStreamStats musicStats = audioManager.getMusicStats();
+        cout << "Streaming da música: " << musicStats.pagesDecoded << " páginas"
+             << " | decodificação média " << musicStats.avgPageDecodeMs << " ms/página"
+             << " (máx " << musicStats.maxPageDecodeMs << " ms)" << endl;
+        cout << "  buffer mínimo " << musicStats.minFillMs << " de " << musicStats.capacityMs << " ms"
+             << " | underruns: " << musicStats.underruns
+             << " (" << musicStats.underrunFrames << " frames de silêncio)" << endl;
+    }
+    printAudioMemory();
+    cout << "=============================\n" << endl;
+
     // Limpeza
     for (auto obj : fallingObjects)
     {
@@ -1024,165 +1610,100 @@ int main()
     }
     backgroundLayers.clear();
 
+    TextureResidencyStats residencyStats = textureResidency.getStats();
+    cout << "Texturas: " << residencyStats.loads << " carregamentos, " << residencyStats.evictions
+         << " removidas da GPU, " << residencyStats.stubBinds << " desenhos com textura provisória" << endl;
+
+    if (config.latencyProbe)
+    {
+        FrameLatencyStats latencyStats = frameLatency.getStats();
+        cout << "Latência entrada -> frame: " << latencyStats.samples << " amostras, média "
+             << latencyStats.averageMs << " ms, p95 " << latencyStats.p95Ms << " ms, máx "
+             << latencyStats.maxMs << " ms" << endl;
+    }
+
+    // Texturas precisam ser apagadas com o contexto ainda ativo
+    frameLatency.destroy();
+    motionBuffer.destroy();
+    textureResidency.clear();
+    textureCache.clear();
+    jobSystem.shutdown();
+    sharedAssets.close(); // o segmento continua para os próximos processos
+
     glfwTerminate();
-    return 0;
+    return replayExitCode;
 }
 
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode)
 {
+    frameLatency.onInput();
+
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         glfwSetWindowShouldClose(window, GL_TRUE);
 
-    if (action == GLFW_PRESS)
-    {
-        keys[key] = true;
-    }
-    else if (action == GLFW_RELEASE)
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS)
+        perfOverlay.toggle();
+
+    // Repetição automática não muda o estado da tecla
+    if (action == GLFW_PRESS || action == GLFW_RELEASE)
     {
-        keys[key] = false;
+        InputEvent event = {glfwGetTime(), action == GLFW_PRESS ? INPUT_KEY_DOWN : INPUT_KEY_UP, key, 0.0f, 0.0f};
+        inputQueue.push(event);
     }
 }
 
 void mouse_callback(GLFWwindow* window, double xpos, double ypos)
 {
-    mouseX = xpos;
-    useMouseControl = true;
+    frameLatency.onInput();
+    InputEvent event = {glfwGetTime(), INPUT_MOUSE_MOVE, 0, (float)xpos, (float)ypos};
+    inputQueue.push(event);
 }
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 {
-    // Clicar para iniciar o jogo ou reiniciar após game over
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
-    {
-        if (gameState == MENU || gameState == GAME_OVER)
-        {
-            gameState = PLAYING;
-            resetGame();
-            cout << "Iniciando o jogo..." << endl;
-        }
-    }
+    frameLatency.onInput();
+    InputEvent event = {glfwGetTime(), action == GLFW_PRESS ? INPUT_MOUSE_DOWN : INPUT_MOUSE_UP, button, 0.0f, 0.0f};
+    inputQueue.push(event);
 }
 
 int setupShader()
 {
-    // Vertex shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-
-    GLint success;
-    GLchar infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << endl;
-    }
-
-    // Fragment shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << endl;
-    }
-
-    // Linkar programa
-    GLuint shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return shaderProgram;
+    // Compila só na primeira execução (ou após trocar de driver): nas
+    // próximas o programa vem pronto do binário em cache
+    return shaderCache.loadProgram(vertexShaderSource, fragmentShaderSource);
 }
 
-TextureInfo loadTextureWithInfo(string filePath)
+// Texturas são só declaradas aqui: o retorno é um handle do TextureResidency,
+// que carrega a textura (pelo cache) quando a cena dela fica ativa ou no
+// primeiro bind. As dimensões já vêm do cabeçalho do arquivo ou do pacote
+TextureInfo loadTextureWithInfo(string filePath, unsigned int scenes)
 {
-    GLuint texID;
-    glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
-
-    if (data)
+    GLuint handle = textureResidency.declare(filePath, scenes);
+    int width = 0, height = 0;
+    if (!textureResidency.getSize(handle, width, height))
     {
-        if (nrChannels == 3)
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        }
-        else
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        }
-        glGenerateMipmap(GL_TEXTURE_2D);
-        cout << "Textura carregada: " << filePath << endl;
+        return TextureInfo();
     }
-    else
-    {
-        cout << "Falha ao carregar textura: " << filePath << endl;
-    }
-
-    stbi_image_free(data);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    return TextureInfo(texID, width, height);
+    return TextureInfo(handle, width, height);
 }
 
-GLuint loadTexture(string filePath)
+// drawWidth/drawHeight: maior tamanho em que o sprite é desenhado (unidades
+// da projeção); a textura é reduzida para isso já na carga
+GLuint loadTexture(string filePath, unsigned int scenes, float drawWidth, float drawHeight)
 {
-    GLuint texID;
-    glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
-
-    if (data)
+    if (!config.textureDownscale || drawWidth <= 0.0f || drawHeight <= 0.0f)
     {
-        if (nrChannels == 3)
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        }
-        else
-        {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        }
-        glGenerateMipmap(GL_TEXTURE_2D);
-        cout << "Textura carregada: " << filePath << endl;
+        return loadTextureWithInfo(filePath, scenes).id;
     }
-    else
-    {
-        cout << "Falha ao carregar textura: " << filePath << endl;
-    }
-
-    stbi_image_free(data);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    int maxWidth = (int)ceil(drawWidth * texturePixelScale);
+    int maxHeight = (int)ceil(drawHeight * texturePixelScale);
+    return textureResidency.declare(filePath, scenes, maxWidth, maxHeight);
+}
 
+// Usa uma textura já declarada em outro lugar (ex.: fallbacks) também nestas cenas
+GLuint shareTexture(GLuint texID, unsigned int scenes)
+{
+    textureResidency.addScenes(texID, scenes);
     return texID;
 }
 
@@ -1400,7 +1921,7 @@ void drawBackgroundLayer(GLuint shaderID, GLuint texID, float xOffset, float zDe
     glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), 0.0f, 0.0f);
 
     // Bind da textura e desenho
-    glBindTexture(GL_TEXTURE_2D, texID);
+    bindTexture(texID);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
@@ -1425,7 +1946,7 @@ void drawCloudLayer(GLuint shaderID, GLuint texID, float xPosition, float zDepth
     glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), 0.0f, 0.0f);
 
     // Bind da textura e desenho
-    glBindTexture(GL_TEXTURE_2D, texID);
+    bindTexture(texID);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
@@ -1447,7 +1968,7 @@ void drawBushLayer(GLuint shaderID, GLuint VAO, GLuint texID, float xOffset, flo
     glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), 0.0f, 0.0f);
 
     // Bind da textura e desenho
-    glBindTexture(GL_TEXTURE_2D, texID);
+    bindTexture(texID);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
@@ -1466,7 +1987,7 @@ void spawnFallingObject()
     {
         // Fruta normal (sprite único com rotação animada)
         GLuint texID = fruitTexIDs[rand() % fruitTexIDs.size()];
-        obj->initialize(basket.getShaderID(), texID, vec3(x, y, 0.0f), vec3(50.0f, 50.0f, 1.0f));
+        obj->initialize(basket.getShaderID(), texID, vec3(x, y, 0.0f), vec3(OBJECT_SIZE, OBJECT_SIZE, 1.0f));
         obj->setType(OBJ_FRUIT);
 
         float rotSpeed = 50.0f + (rand() % 100);
@@ -1483,19 +2004,20 @@ void spawnFallingObject()
             SpritesheetInfo spriteInfo = insectSpritesheets[rand() % insectSpritesheets.size()];
 
             obj->initialize(basket.getShaderID(), spriteInfo.texID,
-                          vec3(x, y, 0.0f), vec3(50.0f, 50.0f, 1.0f),
+                          vec3(x, y, 0.0f), vec3(OBJECT_SIZE, OBJECT_SIZE, 1.0f),
                           spriteInfo.nAnimations, spriteInfo.nFrames);
 
             obj->setType(OBJ_INSECT);
             obj->setAnimated(true);
-            obj->setFPS(12.0f);
+            obj->setFPS(spriteInfo.fps);
+            obj->setAnimationStart(gameTime); // cada inseto começa no frame 0
 
             cout << "Inseto animado spawnou! (" << spriteInfo.nAnimations << "x" << spriteInfo.nFrames << " frames)" << endl;
         }
         else
         {
             GLuint texID = insectTexIDs[rand() % insectTexIDs.size()];
-            obj->initialize(basket.getShaderID(), texID, vec3(x, y, 0.0f), vec3(50.0f, 50.0f, 1.0f));
+            obj->initialize(basket.getShaderID(), texID, vec3(x, y, 0.0f), vec3(OBJECT_SIZE, OBJECT_SIZE, 1.0f));
             obj->setType(OBJ_INSECT);
 
             float rotSpeed = 100.0f + (rand() % 150);
@@ -1506,26 +2028,247 @@ void spawnFallingObject()
     }
 
     obj->setVelocity(vec2(0.0f, -objectFallSpeed));
+
+    if (config.gpuMotion)
+    {
+        // Gravado uma vez: daqui em diante o shader calcula posição e ângulo
+        obj->startMotion(gameTime, basket.getBounds().maxY);
+        obj->setMotionSlot(motionBuffer.allocate());
+    }
+
     fallingObjects.push_back(obj);
 }
 
+int runSimulation(double now)
+{
+    double tick = 1.0 / config.simTickHz;
+
+    // Depois de um engasgo longo (janela arrastada, breakpoint) o tempo
+    // perdido é descartado em vez de simulado de uma vez
+    int maxTicks = max(1, (int)ceil(0.25 * config.simTickHz));
+    int ticks = 0;
+    while (simClock + tick <= now && !replayFinished)
+    {
+        if (ticks == maxTicks)
+        {
+            simClock = now;
+            break;
+        }
+        simulateTick(simClock, (float)tick);
+        simClock += tick;
+        ticks++;
+    }
+    return ticks;
+}
+
+void publishSnapshot()
+{
+    GameSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.state = gameState;
+    snapshot.gameTime = gameTime;
+    snapshot.score = score;
+    snapshot.lives = lives;
+    snapshot.useMouseControl = useMouseControl;
+    basket.getSnapshot(snapshot.basket);
+
+    // O vetor mantém a capacidade: sem alocação depois das primeiras partidas.
+    // Os inativos vão junto (o desenho os pula) para a cópia ser por índice
+    snapshot.objects.resize(fallingObjects.size());
+    jobSystem.parallelFor(fallingObjects.size(), OBJECT_BATCH_SIZE, [&snapshot](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            fallingObjects[i]->getSnapshot(snapshot.objects[i]);
+        }
+    });
+
+    snapshot.bushOscillationTime = bushOscillationTime;
+    snapshot.bushMiddleShakeTime = bushMiddleShakeTime;
+    copy(cloudPositions, cloudPositions + 4, snapshot.cloudPositions);
+    snapshots.publish();
+}
+
+void simulationLoop()
+{
+    double tick = 1.0 / config.simTickHz;
+    GameState publishedState = gameState;
+    while (simRunning && !replayFinished)
+    {
+        if (runSimulation(glfwGetTime()) > 0)
+        {
+            publishSnapshot();
+
+            // O desenho pode estar parado esperando eventos (menu, game over):
+            // acorda para mostrar a troca de tela sem esperar o próximo repouso
+            if (gameState != publishedState)
+            {
+                publishedState = gameState;
+                glfwPostEmptyEvent();
+            }
+        }
+
+        // Dorme até o fim do próximo tick
+        double wait = simClock + tick - glfwGetTime();
+        if (wait > 0.0)
+        {
+            this_thread::sleep_for(chrono::duration<double>(wait));
+        }
+    }
+    if (replayFinished)
+    {
+        glfwPostEmptyEvent();
+    }
+}
+
+void simulateTick(double tickStart, float tick)
+{
+    // Eventos que chegaram até o fim deste tick, com a posição dentro dele
+    tickInput.clear();
+    inputQueue.popUntil(tickStart + tick, pendingInput);
+    if (replayPath.empty())
+    {
+        for (const InputEvent& event : pendingInput)
+        {
+            TickInput input = {event.type, event.code, (float)((event.time - tickStart) / tick), event.x};
+            tickInput.push_back(input);
+        }
+    }
+    else if (gameState == PLAYING)
+    {
+        // No replay a entrada ao vivo é ignorada (ESC e F3 são tratados no callback)
+        replayReader.eventsForTick(simTick, tickInput);
+    }
+    pendingInput.clear();
+
+    inputState.applyTick(tickInput);
+    if (gameState == PLAYING)
+    {
+        replayWriter.record(simTick, tickInput);
+    }
+    if (inputState.mouseMoved())
+    {
+        useMouseControl = true;
+    }
+
+    // Clicar para iniciar o jogo ou reiniciar após game over
+    if (inputState.clicked() && gameState != PLAYING && replayPath.empty())
+    {
+        if (gameState == MENU && !gameplayReady)
+        {
+            cout << "Ainda carregando o jogo..." << endl;
+        }
+        else
+        {
+            startRequested = true;
+        }
+    }
+    if (!replayPath.empty() && gameState == MENU && gameplayReady)
+    {
+        startRequested = true;
+    }
+
+    bool wasPlaying = gameState == PLAYING;
+    updateGame(tick);
+
+    if (wasPlaying)
+    {
+        simTick++;
+        if (gameState != PLAYING && replayWriter.isRecording())
+        {
+            replayWriter.finish(recordPath, simTick, score, lives);
+        }
+
+        // Replay: no tick final (ou num game over antes dele) confere o placar
+        if (!replayPath.empty() && (gameState != PLAYING || simTick >= replayReader.getEndTick()))
+        {
+            bool matches = simTick == replayReader.getEndTick() &&
+                           score == replayReader.getFinalScore() && lives == replayReader.getFinalLives();
+            cout << "Replay " << (matches ? "confere" : "divergiu") << ": " << simTick << " ticks, "
+                 << score << " pontos, " << lives << " vidas (gravado: " << replayReader.getEndTick()
+                 << " ticks, " << replayReader.getFinalScore() << " pontos, "
+                 << replayReader.getFinalLives() << " vidas)" << endl;
+            replayExitCode = matches ? 0 : 1;
+            replayFinished = true;
+            return;
+        }
+    }
+
+    // A partida começa na fronteira de um tick: o estado da entrada neste
+    // ponto é o que o replay guarda
+    if (startRequested)
+    {
+        startRequested = false;
+        startGame();
+    }
+}
+
+void startGame()
+{
+    uint32_t seed;
+    if (!replayPath.empty())
+    {
+        const ReplayHeader& header = replayReader.getHeader();
+        seed = header.seed;
+        inputState.reset(header.mouseX);
+        inputState.setDownKeys(replayReader.getDownKeys());
+        useMouseControl = header.useMouseControl != 0;
+        vec3 pos = basket.getPosition();
+        pos.x = header.basketX;
+        basket.setPosition(pos);
+    }
+    else
+    {
+        seed = (uint32_t)rand();
+    }
+    srand(seed);
+
+    gameState = PLAYING;
+    resetGame();
+    cout << "Iniciando o jogo..." << endl;
+
+    if (!recordPath.empty() && !replayRecorded)
+    {
+        ReplayHeader header;
+        memset(&header, 0, sizeof(header));
+        header.seed = seed;
+        header.tickRate = (float)config.simTickHz;
+        header.gpuMotion = config.gpuMotion ? 1 : 0;
+        header.basketX = basket.getPosition().x;
+        header.mouseX = inputState.getMouseX();
+        header.useMouseControl = useMouseControl ? 1 : 0;
+
+        vector<int> downKeys;
+        inputState.getDownKeys(downKeys);
+        replayWriter.begin(header, downKeys);
+        replayRecorded = true;
+        cout << "Gravando replay em " << recordPath << endl;
+    }
+}
+
 void updateGame(float deltaTime)
 {
     // Só atualizar o jogo se estiver no estado PLAYING
     if (gameState != PLAYING)
         return;
 
-    // Controle da cesta com teclado
+    gameTime += deltaTime;
+
+    // Posição da cesta no início do passo, para a colisão contínua
+    vec3 basketStart = basket.getPosition();
+
+    // Controle da cesta com teclado, proporcional ao tempo que a tecla
+    // ficou pressionada dentro do tick
     float basketSpeed = 300.0f * deltaTime;
+    float left = max(inputState.heldFraction(GLFW_KEY_LEFT), inputState.heldFraction(GLFW_KEY_A));
+    float right = max(inputState.heldFraction(GLFW_KEY_RIGHT), inputState.heldFraction(GLFW_KEY_D));
 
-    if (keys[GLFW_KEY_LEFT] || keys[GLFW_KEY_A])
+    if (left > 0.0f)
     {
-        basket.moveLeft(basketSpeed);
+        basket.moveLeft(basketSpeed * left);
         useMouseControl = false;
     }
-    if (keys[GLFW_KEY_RIGHT] || keys[GLFW_KEY_D])
+    if (right > 0.0f)
     {
-        basket.moveRight(basketSpeed);
+        basket.moveRight(basketSpeed * right);
         useMouseControl = false;
     }
 
@@ -1533,18 +2276,12 @@ void updateGame(float deltaTime)
     if (useMouseControl)
     {
         vec3 pos = basket.getPosition();
-        pos.x = mouseX;
+        pos.x = inputState.getMouseX();
         basket.setPosition(pos);
     }
 
     // Limitar cesta dentro da tela
-    vec3 basketPos = basket.getPosition();
-    vec3 basketDim = basket.getDimensions();
-    if (basketPos.x - basketDim.x / 2 < 0)
-        basketPos.x = basketDim.x / 2;
-    if (basketPos.x + basketDim.x / 2 > WIDTH)
-        basketPos.x = WIDTH - basketDim.x / 2;
-    basket.setPosition(basketPos);
+    clampBasketToScreen();
 
     // Spawnar novos objetos
     spawnTimer += deltaTime;
@@ -1554,33 +2291,54 @@ void updateGame(float deltaTime)
         spawnTimer = 0.0f;
     }
 
-    // Atualizar objetos caindo
-    for (int i = fallingObjects.size() - 1; i >= 0; i--)
+    // Remover objetos inativos (pegos ou fora da tela no passo anterior),
+    // mantendo a ordem dos demais
+    size_t kept = 0;
+    for (size_t i = 0; i < fallingObjects.size(); i++)
     {
         GameObject* obj = fallingObjects[i];
-
-        if (obj->isActive)
+        if (!obj->isActive)
         {
-            obj->updatePosition(deltaTime);
+            motionBuffer.remove(obj->getMotionSlot());
+            delete obj;
+            continue;
+        }
+        fallingObjects[kept++] = obj;
+    }
+    fallingObjects.resize(kept);
 
-            // Verificar se saiu da tela
-            if (obj->getPosition().y < -50.0f)
+    // Atualizar objetos caindo: cada um só mexe em si mesmo, então os blocos
+    // rodam em paralelo com o mesmo resultado (e o replay continua batendo)
+    jobSystem.parallelFor(fallingObjects.size(), OBJECT_BATCH_SIZE, [deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            GameObject* obj = fallingObjects[i];
+            if (!config.gpuMotion)
+            {
+                obj->updatePosition(deltaTime);
+            }
+            else if (gameTime >= obj->getBandEnterTime() || obj->getMotionSlot() < 0)
             {
-                obj->isActive = false;
+                // Na GPU, a CPU só calcula quem já chegou à faixa da cesta (e
+                // daí até sair da tela); sem slot, o objeto é desenhado pela CPU
+                obj->updateAnalytic(gameTime);
             }
         }
+    });
 
-        // Remover objetos inativos
-        if (!obj->isActive)
+    // Verificar colisões (ao longo de todo o passo, não só na posição final)
+    checkCollisions(deltaTime, basketStart);
+
+    // Verificar se saíram da tela só depois da colisão: num passo longo o
+    // objeto pode atravessar a cesta e passar da borda no mesmo passo
+    for (auto obj : fallingObjects)
+    {
+        if (obj->isActive && obj->getPosition().y < -50.0f)
         {
-            delete obj;
-            fallingObjects.erase(fallingObjects.begin() + i);
+            obj->isActive = false;
         }
     }
 
-    // Verificar colisões
-    checkCollisions();
-
     // Aumentar dificuldade com o tempo
     difficultyTimer += deltaTime;
     if (difficultyTimer >= difficultyIncreaseRate)
@@ -1626,31 +2384,109 @@ void updateGame(float deltaTime)
     }
 }
 
-void checkCollisions()
+void clampBasketToScreen()
 {
+    vec3 basketPos = basket.getPosition();
+    vec3 basketDim = basket.getDimensions();
+    if (basketPos.x - basketDim.x / 2 < 0)
+        basketPos.x = basketDim.x / 2;
+    if (basketPos.x + basketDim.x / 2 > WIDTH)
+        basketPos.x = WIDTH - basketDim.x / 2;
+    basket.setPosition(basketPos);
+}
+
+void checkCollisions(float deltaTime, vec3 basketStart)
+{
+    // Colisão contínua: cada caixa é tomada no início do passo com o
+    // deslocamento até o fim dele, então um objeto rápido (ou um passo longo)
+    // não atravessa a cesta entre dois ticks
+    vec3 basketEnd = basket.getPosition();
+    vec3 basketDim = basket.getDimensions();
+    AABB basketBounds = makeAABB(basketStart.x, basketStart.y, basketDim.x, basketDim.y);
+    vec2 basketMotion(basketEnd.x - basketStart.x, basketEnd.y - basketStart.y);
+
+    // Broadphase: caixas varridas (início + fim) na grade; só os objetos nas
+    // células da varredura da cesta chegam ao teste exato
+    collisionBoxes.clear();
+    collisionObjects.clear();
+    collisionMotion.clear();
     for (auto obj : fallingObjects)
     {
-        if (obj->isActive && basket.checkCollision(*obj))
+        // Com GPU_MOTION, quem ainda não chegou à faixa da cesta não tem posição na CPU
+        if (obj->isActive && (!config.gpuMotion || gameTime >= obj->getBandEnterTime()))
         {
-            if (obj->getType() == OBJ_FRUIT)
-            {
-                score++;
-                cout << "Fruta coletada! Score: " << score << endl;
-                audioManager.playSound("fruit_collect"); // Tocar som de coleta de fruta
-            }
-            else if (obj->getType() == OBJ_INSECT)
+            vec2 motion = obj->getVelocity() * deltaTime;
+            AABB end = obj->getBounds();
+            AABB start = { end.minX - motion.x, end.minY - motion.y, end.maxX - motion.x, end.maxY - motion.y };
+            collisionBoxes.push_back(sweptBounds(start, motion.x, motion.y));
+            collisionObjects.push_back(obj);
+            collisionMotion.push_back(motion);
+        }
+    }
+    collisionGrid.build(collisionBoxes);
+    AABB basketSwept = sweptBounds(basketBounds, basketMotion.x, basketMotion.y);
+    collisionGrid.query(basketSwept, collisionCandidates);
+
+    // Filtro em lote (SIMD) entre as varreduras
+    candidateBoxes.clear();
+    for (uint32_t candidate : collisionCandidates)
+    {
+        candidateBoxes.push_back(collisionBoxes[candidate]);
+    }
+    candidateHits.resize((candidateBoxes.size() + 63) / 64);
+    if (!basket.isActive || overlapBatch(basketSwept, candidateBoxes.data(), candidateBoxes.size(), candidateHits.data()) == 0)
+    {
+        return;
+    }
+
+    // Teste exato: instante do primeiro contato de cada objeto com a cesta
+    collisionHits.clear();
+    for (size_t i = 0; i < collisionCandidates.size(); i++)
+    {
+        if ((candidateHits[i / 64] >> (i % 64) & 1) == 0) continue;
+
+        uint32_t candidate = collisionCandidates[i];
+        GameObject* obj = collisionObjects[candidate];
+        vec2 motion = collisionMotion[candidate];
+        vec3 pos = obj->getPosition();
+        vec3 dim = obj->getDimensions();
+        AABB start = makeAABB(pos.x - motion.x, pos.y - motion.y, dim.x, dim.y);
+
+        float timeOfImpact;
+        if (sweepAABB(start, motion.x, motion.y, basketBounds, basketMotion.x, basketMotion.y, timeOfImpact))
+        {
+            collisionHits.push_back({ obj, timeOfImpact });
+        }
+    }
+
+    // Na ordem em que aconteceram: o que chega depois do game over não conta
+    sort(collisionHits.begin(), collisionHits.end(), [](const CollisionHit& a, const CollisionHit& b) {
+        return a.timeOfImpact < b.timeOfImpact;
+    });
+
+    for (const CollisionHit& hit : collisionHits)
+    {
+        if (gameState != PLAYING) break;
+
+        GameObject* obj = hit.object;
+        if (obj->getType() == OBJ_FRUIT)
+        {
+            score++;
+            cout << "Fruta coletada! Score: " << score << endl;
+            audioManager.playSound("fruit_collect"); // Tocar som de coleta de fruta
+        }
+        else if (obj->getType() == OBJ_INSECT)
+        {
+            lives--;
+            cout << "Inseto coletado! Vidas restantes: " << lives << endl;
+            audioManager.playSound("bug_collect"); // Tocar som de coleta de inseto
+            if (lives <= 0)
             {
-                lives--;
-                cout << "Inseto coletado! Vidas restantes: " << lives << endl;
-                audioManager.playSound("bug_collect"); // Tocar som de coleta de inseto
-                if (lives <= 0)
-                {
-                    cout << "Game Over! Score final: " << score << endl;
-                    gameState = GAME_OVER;
-                }
+                cout << "Game Over! Score final: " << score << endl;
+                gameState = GAME_OVER;
             }
-            obj->isActive = false;
         }
+        obj->isActive = false;
     }
 }
 
@@ -1664,6 +2500,10 @@ void resetGame()
         delete obj;
     }
     fallingObjects.clear();
+    motionBuffer.clear();
+    gameTime = 0.0f;
+    spawnTimer = 0.0f;
+    simTick = 0;
 
     // Resetar dificuldade
     spawnInterval = baseSpawnInterval;
@@ -1714,30 +2554,17 @@ void drawHUDElement(GLuint shaderID, GLuint texID, float x, float y, float width
     glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
     glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), 0.0f, 0.0f);
 
-    glBindTexture(GL_TEXTURE_2D, texID);
+    bindTexture(texID);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 }
 
 GLuint createColoredQuadTexture(float r, float g, float b, float a)
 {
-    GLuint texID;
-    glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
-
-    // Criar um quadro colorido (1x1 pixel) com a cor desejada
-    unsigned char pixel[4] = { (unsigned char)(r * 255), (unsigned char)(g * 255), (unsigned char)(b * 255), (unsigned char)(a * 255) };
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return texID;
+    // Quadro colorido (1x1 pixel) com a cor desejada, compartilhado por cor
+    return textureResidency.declareSolidColor(r, g, b, a);
 }
 
-void drawHUD(GLuint shaderID)
+void drawHUD(GLuint shaderID, int score, int lives)
 {
     // Desabilitar depth test para HUD ficar sempre na frente
     glDisable(GL_DEPTH_TEST);
@@ -1800,3 +2627,91 @@ void drawNumber(GLuint shaderID, int number, float x, float y, float digitSize,
         }
     }
 }
+
+// Mostra quanto de memória o áudio está usando, por categoria
+void printAudioMemory()
+{
+    AudioMemoryStats mem = audioManager.getMemoryStats();
+    cout << "Memória de áudio: " << mem.totalBytes / 1024 << " KB"
+         << " (motor " << mem.bytesInUse[AUDIO_MEM_ENGINE] / 1024 << " KB"
+         << ", streaming " << mem.bytesInUse[AUDIO_MEM_STREAM] / 1024 << " KB"
+         << ", efeitos " << mem.bytesInUse[AUDIO_MEM_SFX] / 1024 << " KB)"
+         << " | pico " << mem.peakBytes / 1024 << " KB";
+    if (mem.budgetBytes > 0) {
+        cout << " de " << mem.budgetBytes / 1024 << " KB";
+    }
+    if (mem.failedAllocations > 0) {
+        cout << " | " << mem.failedAllocations << " alocações recusadas";
+    }
+    cout << endl;
+}
+
+// Publica as métricas de áudio no overlay de desempenho
+void updatePerfOverlay()
+{
+    AudioStats audioStats = audioManager.getStats();
+    ostringstream mix;
+    mix.precision(2);
+    mix << fixed << audioStats.mixTimeMs << " ms, " << audioStats.activeVoices << " vozes";
+    perfOverlay.set("mix", mix.str());
+
+    TextureResidencyStats textureStats = textureResidency.getStats();
+    ostringstream textures;
+    textures << textureStats.resident << "/" << textureStats.declared
+             << " (" << textureStats.bytesResident / (1024 * 1024) << " MB), provisórias " << textureStats.stubBinds;
+    if (textureStats.decoding > 0) textures << ", decodificando " << textureStats.decoding;
+    perfOverlay.set("texturas", textures.str());
+
+    if (audioManager.isMusicStreamed())
+    {
+        MusicStreamStats musicStats = audioManager.getMusicStats();
+        ostringstream music;
+        music.precision(1);
+        music << fixed << "dec " << musicStats.lastPageDecodeMs << " ms/pág, mín "
+              << musicStats.minFillMs << "/" << musicStats.capacityMs << " ms, underruns "
+              << musicStats.underruns;
+        perfOverlay.set("música", music.str());
+    }
+
+    JobSystemStats jobStats = jobSystem.getStats();
+    ostringstream jobs;
+    jobs << jobStats.workers << " workers, " << jobStats.executed << " executados, "
+         << jobStats.stolen << " roubados";
+    perfOverlay.set("jobs", jobs.str());
+
+    FramePacerStats pacerStats = framePacer.getStats();
+    ostringstream pacing;
+    pacing.precision(1);
+    pacing << fixed << (pacerStats.targetFps > 0 ? to_string(pacerStats.targetFps) + " fps" : string("vsync"))
+           << ", sleep " << pacerStats.sleptMs << " + spin " << pacerStats.spunMs << " ms"
+           << " (margem " << pacerStats.spinMarginMs << "), atrasos " << pacerStats.lateFrames;
+    perfOverlay.set("ritmo", pacing.str());
+
+    FrameLatencyStats latencyStats = frameLatency.getStats();
+    if (config.latencyProbe || config.frameQueueLimit > 0)
+    {
+        ostringstream latency;
+        latency.precision(1);
+        latency << fixed;
+        if (config.latencyProbe)
+            latency << latencyStats.averageMs << " ms (p95 " << latencyStats.p95Ms << "), ";
+        latency << "espera da GPU " << latencyStats.queueWaitMs << " ms";
+        perfOverlay.set("latência", latency.str());
+    }
+}
+
+// Mostra quantas texturas estão na GPU e quanto ocupam
+void printTextureMemory()
+{
+    TextureCacheStats stats = textureCache.getStats();
+    cout << "Texturas residentes: " << stats.textures << " (" << stats.bytesResident / 1024 << " KB)"
+         << " | carregadas " << stats.loads
+         << " | reaproveitadas por caminho " << stats.pathHits
+         << ", por conteúdo " << stats.contentHits << endl;
+
+    TextureResidencyStats residency = textureResidency.getStats();
+    cout << "Texturas declaradas: " << residency.declared << " | na GPU: " << residency.resident
+         << " | orçamento: ";
+    if (residency.budgetBytes > 0) cout << residency.budgetBytes / (1024 * 1024) << " MB" << endl;
+    else cout << "sem limite" << endl;
+}
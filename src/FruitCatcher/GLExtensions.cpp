@@ -0,0 +1,51 @@
+#include "GLExtensions.h"
+
+#include <iostream>
+#include <cstring>
+
+GLExtensions glExtensions;
+
+static bool versionAtLeast(int major, int minor)
+{
+    GLint currentMajor = 0, currentMinor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &currentMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &currentMinor);
+    return currentMajor > major || (currentMajor == major && currentMinor >= minor);
+}
+
+bool hasGLExtension(const string& name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (extension != nullptr && name == extension) return true;
+    }
+    return false;
+}
+
+void loadGLExtensions(GLADloadproc loader)
+{
+    if (versionAtLeast(4, 2) || hasGLExtension("GL_ARB_texture_storage")) {
+        glExtensions.texStorage2D = (PFNFCTEXSTORAGE2DPROC)loader("glTexStorage2D");
+        glExtensions.textureStorage = glExtensions.texStorage2D != nullptr;
+    }
+
+    glExtensions.compressionBPTC = versionAtLeast(4, 2) || hasGLExtension("GL_ARB_texture_compression_bptc");
+
+    // Alguns drivers expõem a função mas nenhum formato de binário
+    if (versionAtLeast(4, 1) || hasGLExtension("GL_ARB_get_program_binary")) {
+        glExtensions.getProgramBinary = (PFNFCGETPROGRAMBINARYPROC)loader("glGetProgramBinary");
+        glExtensions.programBinaryLoad = (PFNFCPROGRAMBINARYPROC)loader("glProgramBinary");
+        glExtensions.programParameteri = (PFNFCPROGRAMPARAMETERIPROC)loader("glProgramParameteri");
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        glExtensions.programBinary = formats > 0 && glExtensions.getProgramBinary != nullptr &&
+                                     glExtensions.programBinaryLoad != nullptr && glExtensions.programParameteri != nullptr;
+    }
+
+    cout << "Extensões: glTexStorage2D " << (glExtensions.textureStorage ? "sim" : "não")
+         << " | BC7 " << (glExtensions.compressionBPTC ? "sim" : "não")
+         << " | binários de shader " << (glExtensions.programBinary ? "sim" : "não") << endl;
+}
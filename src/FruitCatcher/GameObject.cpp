@@ -1,11 +1,18 @@
 #include "GameObject.h"
 
+#include <cmath>
+
 GameObject::GameObject() : Sprite()
 {
     velocity = vec2(0.0, 0.0);
     type = OBJ_FRUIT;
     rotationSpeed = 0.0f; // sem rotação por padrão
     animated = false; // não é animado por padrão
+    spawnTime = 0.0f;
+    spawnPos = vec3(0.0f);
+    spawnAngle = 0.0f;
+    bandEnterTime = 0.0f;
+    motionSlot = -1;
 }
 
 GameObject::~GameObject()
@@ -66,3 +73,49 @@ void GameObject::updatePosition(float deltaTime)
     if (angle >= 360.0f) angle -= 360.0f;
     if (angle < 0.0f) angle += 360.0f;
 }
+
+void GameObject::startMotion(float time, float bandY)
+{
+    spawnTime = time;
+    spawnPos = pos;
+    spawnAngle = angle;
+
+    // Quando a base do objeto chega a 'bandY' (só se estiver descendo)
+    float bottom = pos.y - dimensions.y / 2.0f;
+    if (velocity.y < 0.0f && bottom > bandY)
+        bandEnterTime = time + (bandY - bottom) / velocity.y;
+    else
+        bandEnterTime = time;
+}
+
+void GameObject::updateAnalytic(float time)
+{
+    // Mesma fórmula do vertex shader
+    float elapsed = time - spawnTime;
+    pos.x = spawnPos.x + velocity.x * elapsed;
+    pos.y = spawnPos.y + velocity.y * elapsed;
+
+    if (!animated) {
+        angle = fmod(spawnAngle + rotationSpeed * elapsed, 360.0f);
+        if (angle < 0.0f) angle += 360.0f;
+    }
+}
+
+MotionParams GameObject::getMotionParams() const
+{
+    MotionParams motion;
+    motion.spawnPos = spawnPos;
+    motion.velocity = velocity;
+    motion.spawnTime = spawnTime;
+    motion.spawnAngle = spawnAngle;
+    motion.rotationSpeed = animated ? 0.0f : rotationSpeed;
+    motion.size = dimensions;
+    return motion;
+}
+
+void GameObject::getSnapshot(ObjectSnapshot& out) const
+{
+    Sprite::getSnapshot(out.sprite);
+    out.motionSlot = motionSlot;
+    out.motion = getMotionParams();
+}
@@ -0,0 +1,339 @@
+#include "ImageOps.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGEOPS_SSE2 1
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IMAGEOPS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef IMAGEOPS_SSE2
+// SSSE3 (pshufb) é verificado em tempo de execução: o build padrão só assume SSE2
+#if defined(__GNUC__) || defined(__clang__)
+#define IMAGEOPS_TARGET_SSSE3 __attribute__((target("ssse3")))
+static bool cpuHasSSSE3()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+#else
+#define IMAGEOPS_TARGET_SSSE3
+static bool cpuHasSSSE3()
+{
+    static const bool supported = [] {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+    }();
+    return supported;
+}
+#endif
+#endif
+
+// Pixels de origem (e pesos) que formam um pixel de destino em uma dimensão
+struct FilterSpan {
+    int first;
+    int count;
+    size_t weightOffset;
+};
+
+static void buildSpans(int srcSize, int dstSize, vector<FilterSpan>& spans, vector<float>& weights)
+{
+    double scale = (double)srcSize / dstSize;
+    spans.resize(dstSize);
+    weights.clear();
+
+    for (int i = 0; i < dstSize; i++) {
+        double start = i * scale;
+        double end = min((double)srcSize, (i + 1) * scale);
+        int first = (int)floor(start);
+        int last = min(srcSize, (int)ceil(end));
+
+        spans[i].first = first;
+        spans[i].count = last - first;
+        spans[i].weightOffset = weights.size();
+        for (int s = first; s < last; s++) {
+            double covered = min((double)(s + 1), end) - max((double)s, start);
+            weights.push_back((float)(covered / scale));
+        }
+    }
+}
+
+#ifdef IMAGEOPS_SSE2
+static inline __m128 loadPixel(const unsigned char* pixel)
+{
+    int32_t packed;
+    memcpy(&packed, pixel, 4);
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_cvtsi32_si128(packed);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+}
+
+static inline void storePixel(unsigned char* pixel, __m128 value)
+{
+    __m128i rounded = _mm_cvttps_epi32(_mm_add_ps(value, _mm_set1_ps(0.5f)));
+    __m128i words = _mm_packs_epi32(rounded, rounded);
+    int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    memcpy(pixel, &packed, 4);
+}
+#endif
+
+void resizeRGBA(const unsigned char* src, int srcWidth, int srcHeight,
+                unsigned char* dst, int dstWidth, int dstHeight)
+{
+    dstWidth = max(1, min(dstWidth, srcWidth));
+    dstHeight = max(1, min(dstHeight, srcHeight));
+    if (dstWidth == srcWidth && dstHeight == srcHeight) {
+        memcpy(dst, src, (size_t)srcWidth * srcHeight * 4);
+        return;
+    }
+
+    vector<FilterSpan> columns, rows;
+    vector<float> columnWeights, rowWeights;
+    buildSpans(srcWidth, dstWidth, columns, columnWeights);
+    buildSpans(srcHeight, dstHeight, rows, rowWeights);
+
+    // 1ª passada: horizontal, para float (srcHeight linhas de dstWidth pixels)
+    vector<float> horizontal((size_t)dstWidth * srcHeight * 4);
+    for (int y = 0; y < srcHeight; y++) {
+        const unsigned char* srcRow = src + (size_t)y * srcWidth * 4;
+        float* outRow = horizontal.data() + (size_t)y * dstWidth * 4;
+
+        for (int x = 0; x < dstWidth; x++) {
+            const FilterSpan& span = columns[x];
+            const float* weights = columnWeights.data() + span.weightOffset;
+            const unsigned char* pixel = srcRow + (size_t)span.first * 4;
+#ifdef IMAGEOPS_SSE2
+            __m128 sum = _mm_setzero_ps();
+            for (int k = 0; k < span.count; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(loadPixel(pixel + k * 4), _mm_set1_ps(weights[k])));
+            }
+            _mm_storeu_ps(outRow + x * 4, sum);
+#else
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int k = 0; k < span.count; k++) {
+                for (int c = 0; c < 4; c++) sum[c] += pixel[k * 4 + c] * weights[k];
+            }
+            memcpy(outRow + x * 4, sum, sizeof(sum));
+#endif
+        }
+    }
+
+    // 2ª passada: vertical, acumulando linhas inteiras (acesso sequencial)
+    vector<float> accum((size_t)dstWidth * 4);
+    for (int y = 0; y < dstHeight; y++) {
+        const FilterSpan& span = rows[y];
+        const float* weights = rowWeights.data() + span.weightOffset;
+        fill(accum.begin(), accum.end(), 0.0f);
+
+        for (int k = 0; k < span.count; k++) {
+            const float* inRow = horizontal.data() + (size_t)(span.first + k) * dstWidth * 4;
+            size_t i = 0;
+#ifdef IMAGEOPS_SSE2
+            __m128 weight = _mm_set1_ps(weights[k]);
+            for (; i < accum.size(); i += 4) {
+                __m128 sum = _mm_loadu_ps(accum.data() + i);
+                _mm_storeu_ps(accum.data() + i, _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(inRow + i), weight)));
+            }
+#endif
+            for (; i < accum.size(); i++) {
+                accum[i] += inRow[i] * weights[k];
+            }
+        }
+
+        unsigned char* dstRow = dst + (size_t)y * dstWidth * 4;
+        for (int x = 0; x < dstWidth; x++) {
+#ifdef IMAGEOPS_SSE2
+            storePixel(dstRow + x * 4, _mm_loadu_ps(accum.data() + x * 4));
+#else
+            for (int c = 0; c < 4; c++) {
+                int value = (int)(accum[x * 4 + c] + 0.5f);
+                dstRow[x * 4 + c] = (unsigned char)min(255, max(0, value));
+            }
+#endif
+        }
+    }
+}
+
+// Média 2x2 de um pixel de destino, repetindo a borda em dimensões ímpares
+static void averageBlock(const unsigned char* src, int width, int height, int x, int y, unsigned char* out)
+{
+    int y0 = min(y * 2, height - 1);
+    int y1 = min(y * 2 + 1, height - 1);
+    int x0 = min(x * 2, width - 1);
+    int x1 = min(x * 2 + 1, width - 1);
+    for (int c = 0; c < 4; c++) {
+        int sum = src[((size_t)y0 * width + x0) * 4 + c] + src[((size_t)y0 * width + x1) * 4 + c] +
+                  src[((size_t)y1 * width + x0) * 4 + c] + src[((size_t)y1 * width + x1) * 4 + c];
+        out[c] = (unsigned char)((sum + 2) / 4);
+    }
+}
+
+void downsampleRGBA(const unsigned char* src, int width, int height,
+                    vector<unsigned char>& dst, int& outWidth, int& outHeight)
+{
+    outWidth = max(1, width / 2);
+    outHeight = max(1, height / 2);
+    dst.resize((size_t)outWidth * outHeight * 4);
+
+    for (int y = 0; y < outHeight; y++) {
+        unsigned char* outRow = dst.data() + (size_t)y * outWidth * 4;
+        int x = 0;
+#ifdef IMAGEOPS_SSE2
+        // Blocos 2x2 completos, dois pixels de destino (16 bytes de origem por linha) por vez
+        if (y * 2 + 1 < height) {
+            const unsigned char* row0 = src + (size_t)(y * 2) * width * 4;
+            const unsigned char* row1 = row0 + (size_t)width * 4;
+            __m128i zero = _mm_setzero_si128();
+            __m128i rounding = _mm_set1_epi16(2);
+            for (; x + 1 < outWidth && x * 2 + 3 < width; x += 2) {
+                __m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+                __m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+                __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+                high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+                __m128i sums = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding), 2);
+                _mm_storel_epi64((__m128i*)(outRow + x * 4), _mm_packus_epi16(sums, zero));
+            }
+        }
+#endif
+        for (; x < outWidth; x++) {
+            averageBlock(src, width, height, x, y, outRow + x * 4);
+        }
+    }
+}
+
+int mipLevelCount(int width, int height)
+{
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = max(1, width / 2);
+        height = max(1, height / 2);
+        levels++;
+    }
+    return levels;
+}
+
+#ifdef IMAGEOPS_SSE2
+// 4 pixels por iteração; lê 16 bytes para usar 12, por isso para 2 pixels antes do fim
+IMAGEOPS_TARGET_SSSE3 static size_t expandRGBToRGBA_SSSE3(const unsigned char* rgb, unsigned char* rgba, size_t pixelCount)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+    size_t i = 0;
+    for (; i + 6 <= pixelCount; i += 4) {
+        __m128i source = _mm_loadu_si128((const __m128i*)(rgb + i * 3));
+        _mm_storeu_si128((__m128i*)(rgba + i * 4), _mm_or_si128(_mm_shuffle_epi8(source, shuffle), alpha));
+    }
+    return i;
+}
+#endif
+
+void expandRGBToRGBA(const unsigned char* rgb, unsigned char* rgba, size_t pixelCount)
+{
+    size_t i = 0;
+#if defined(IMAGEOPS_SSE2)
+    if (cpuHasSSSE3()) {
+        i = expandRGBToRGBA_SSSE3(rgb, rgba, pixelCount);
+    }
+#elif defined(IMAGEOPS_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8x3_t source = vld3_u8(rgb + i * 3);
+        uint8x8x4_t expanded;
+        expanded.val[0] = source.val[0];
+        expanded.val[1] = source.val[1];
+        expanded.val[2] = source.val[2];
+        expanded.val[3] = vdup_n_u8(255);
+        vst4_u8(rgba + i * 4, expanded);
+    }
+#endif
+    for (; i < pixelCount; i++) {
+        rgba[i * 4 + 0] = rgb[i * 3 + 0];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+// round(value * alpha / 255) sem divisão
+static inline unsigned char multiplyAlpha(unsigned int value, unsigned int alpha)
+{
+    unsigned int t = value * alpha + 128;
+    return (unsigned char)((t + (t >> 8)) >> 8);
+}
+
+void premultiplyAlpha(unsigned char* rgba, size_t pixelCount)
+{
+    size_t i = 0;
+#if defined(IMAGEOPS_SSE2)
+    // 4 pixels por iteração, 2 em cada metade de 16 bits; o alfa é multiplicado por 255 (fica igual)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i keepAlpha = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rounding = _mm_set1_epi16(128);
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(rgba + i * 4));
+        __m128i halves[2] = { _mm_unpacklo_epi8(pixels, zero), _mm_unpackhi_epi8(pixels, zero) };
+        for (__m128i& half : halves) {
+            __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(half, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i t = _mm_add_epi16(_mm_mullo_epi16(half, _mm_or_si128(alpha, keepAlpha)), rounding);
+            half = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        }
+        _mm_storeu_si128((__m128i*)(rgba + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+    }
+#elif defined(IMAGEOPS_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8x4_t pixels = vld4_u8(rgba + i * 4);
+        for (int c = 0; c < 3; c++) {
+            uint16x8_t t = vmull_u8(pixels.val[c], pixels.val[3]);
+            t = vaddq_u16(t, vrshrq_n_u16(t, 8));
+            pixels.val[c] = vrshrn_n_u16(t, 8);
+        }
+        vst4_u8(rgba + i * 4, pixels);
+    }
+#endif
+    for (; i < pixelCount; i++) {
+        unsigned int alpha = rgba[i * 4 + 3];
+        for (int c = 0; c < 3; c++) {
+            rgba[i * 4 + c] = multiplyAlpha(rgba[i * 4 + c], alpha);
+        }
+    }
+}
+
+void flipRowsRGBA(unsigned char* rgba, int width, int height)
+{
+    size_t rowBytes = (size_t)width * 4;
+    for (int y = 0; y < height / 2; y++) {
+        unsigned char* top = rgba + (size_t)y * rowBytes;
+        unsigned char* bottom = rgba + (size_t)(height - 1 - y) * rowBytes;
+        size_t i = 0;
+#if defined(IMAGEOPS_SSE2)
+        for (; i + 16 <= rowBytes; i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(top + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(bottom + i));
+            _mm_storeu_si128((__m128i*)(top + i), b);
+            _mm_storeu_si128((__m128i*)(bottom + i), a);
+        }
+#elif defined(IMAGEOPS_NEON)
+        for (; i + 16 <= rowBytes; i += 16) {
+            uint8x16_t a = vld1q_u8(top + i);
+            uint8x16_t b = vld1q_u8(bottom + i);
+            vst1q_u8(top + i, b);
+            vst1q_u8(bottom + i, a);
+        }
+#endif
+        for (; i < rowBytes; i++) {
+            swap(top[i], bottom[i]);
+        }
+    }
+}
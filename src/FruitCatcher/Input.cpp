@@ -0,0 +1,117 @@
+#include "Input.h"
+
+#include <algorithm>
+
+InputQueue::InputQueue() : head(0), tail(0), dropped(0)
+{
+}
+
+bool InputQueue::push(const InputEvent& event)
+{
+    size_t writeIndex = tail.load(memory_order_relaxed);
+    if (writeIndex - head.load(memory_order_acquire) >= CAPACITY) {
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    ring[writeIndex % CAPACITY] = event;
+    tail.store(writeIndex + 1, memory_order_release);
+    return true;
+}
+
+size_t InputQueue::popUntil(double until, vector<InputEvent>& out)
+{
+    size_t readIndex = head.load(memory_order_relaxed);
+    size_t available = tail.load(memory_order_acquire);
+    size_t count = 0;
+    while (readIndex < available && ring[readIndex % CAPACITY].time <= until) {
+        out.push_back(ring[readIndex % CAPACITY]);
+        readIndex++;
+        count++;
+    }
+    head.store(readIndex, memory_order_release);
+    return count;
+}
+
+InputState::InputState()
+{
+    reset(0.0f);
+}
+
+void InputState::reset(float mouseX)
+{
+    fill(down, down + MAX_KEYS, false);
+    fill(held, held + MAX_KEYS, 0.0f);
+    this->mouseX = mouseX;
+    moved = false;
+    click = false;
+}
+
+void InputState::applyTick(const vector<TickInput>& events)
+{
+    // Teclas que já estavam pressionadas contam desde o início do tick
+    float pressedAt[MAX_KEYS];
+    for (int key = 0; key < MAX_KEYS; key++) {
+        held[key] = 0.0f;
+        pressedAt[key] = down[key] ? 0.0f : -1.0f;
+    }
+    moved = false;
+    click = false;
+
+    for (const TickInput& event : events) {
+        float fraction = min(1.0f, max(0.0f, event.fraction));
+        switch (event.type) {
+        case INPUT_KEY_DOWN:
+            if (validKey(event.code) && !down[event.code]) {
+                down[event.code] = true;
+                pressedAt[event.code] = fraction;
+            }
+            break;
+        case INPUT_KEY_UP:
+            if (validKey(event.code) && down[event.code]) {
+                held[event.code] += fraction - pressedAt[event.code];
+                down[event.code] = false;
+                pressedAt[event.code] = -1.0f;
+            }
+            break;
+        case INPUT_MOUSE_MOVE:
+            mouseX = event.x;
+            moved = true;
+            break;
+        case INPUT_MOUSE_DOWN:
+            if (event.code == 0) click = true; // GLFW_MOUSE_BUTTON_LEFT
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (int key = 0; key < MAX_KEYS; key++) {
+        if (down[key]) held[key] += 1.0f - pressedAt[key];
+    }
+}
+
+bool InputState::isDown(int key) const
+{
+    return validKey(key) && down[key];
+}
+
+float InputState::heldFraction(int key) const
+{
+    return validKey(key) ? held[key] : 0.0f;
+}
+
+void InputState::getDownKeys(vector<int>& out) const
+{
+    out.clear();
+    for (int key = 0; key < MAX_KEYS; key++) {
+        if (down[key]) out.push_back(key);
+    }
+}
+
+void InputState::setDownKeys(const vector<int>& keys)
+{
+    fill(down, down + MAX_KEYS, false);
+    for (int key : keys) {
+        if (validKey(key)) down[key] = true;
+    }
+}
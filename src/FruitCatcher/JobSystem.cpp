@@ -0,0 +1,249 @@
+#include "JobSystem.h"
+
+#include <iostream>
+#include <algorithm>
+
+// Fila da thread atual (só vale para o JobSystem que a criou)
+static thread_local const JobSystem* workerOwner = nullptr;
+static thread_local int workerQueue = 0;
+
+JobSystem::JobSystem() : queued(0), stopping(false), executed(0), stolen(0)
+{
+    queues.emplace_back(new WorkQueue());
+}
+
+JobSystem::~JobSystem()
+{
+    shutdown();
+}
+
+void JobSystem::initialize(int workerCount)
+{
+    if (!workers.empty()) return;
+
+    if (workerCount < 0) {
+        unsigned int hardware = thread::hardware_concurrency();
+        workerCount = hardware > 1 ? (int)hardware - 1 : (hardware == 0 ? 1 : 0);
+    }
+
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = false;
+    }
+    for (int i = 0; i < workerCount; i++) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+    cout << "Sistema de jobs: " << workerCount << " worker(s) (" << thread::hardware_concurrency()
+         << " threads de hardware)" << endl;
+}
+
+void JobSystem::shutdown()
+{
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Jobs que sobraram na fila de fora rodam aqui mesmo
+    while (tryRunOne()) {
+    }
+    queues.resize(1);
+}
+
+int JobSystem::currentQueue() const
+{
+    return workerOwner == this ? workerQueue : 0;
+}
+
+void JobSystem::run(function<void()> task, JobCounter* counter)
+{
+    if (counter != nullptr) counter->pending.fetch_add(1, memory_order_relaxed);
+    push({move(task), counter});
+}
+
+void JobSystem::runAfter(JobCounter& dependency, function<void()> task, JobCounter* counter)
+{
+    if (counter != nullptr) counter->pending.fetch_add(1, memory_order_relaxed);
+    {
+        // Quem zera o contador pega a trava antes de enviar as continuações
+        lock_guard<mutex> guard(dependency.lock);
+        if (!dependency.isDone()) {
+            dependency.continuations.push_back({move(task), counter});
+            return;
+        }
+    }
+    push({move(task), counter});
+}
+
+void JobSystem::push(Job job)
+{
+    WorkQueue& queue = *queues[currentQueue()];
+    {
+        lock_guard<mutex> guard(queue.lock);
+        queue.jobs.push_back(move(job));
+    }
+    queued.fetch_add(1, memory_order_release);
+
+    // Passar pela trava evita perder o aviso de um worker indo dormir agora
+    {
+        lock_guard<mutex> guard(sleepLock);
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::takeJobOf(const JobCounter& counter, Job& job)
+{
+    int self = currentQueue();
+    int count = (int)queues.size();
+    for (int i = 0; i < count; i++) {
+        WorkQueue& queue = *queues[(self + i) % count];
+        lock_guard<mutex> guard(queue.lock);
+        for (auto it = queue.jobs.rbegin(); it != queue.jobs.rend(); ++it) {
+            if (it->counter != &counter) continue;
+            job = move(*it);
+            queue.jobs.erase(next(it).base());
+            queued.fetch_sub(1, memory_order_relaxed);
+            if (i > 0) stolen.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::takeJob(Job& job)
+{
+    int self = currentQueue();
+
+    // Da própria fila, pelo fim
+    {
+        WorkQueue& queue = *queues[self];
+        lock_guard<mutex> guard(queue.lock);
+        if (!queue.jobs.empty()) {
+            job = move(queue.jobs.back());
+            queue.jobs.pop_back();
+            queued.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Roubo: pelo começo das outras filas, a partir da vizinha
+    int count = (int)queues.size();
+    for (int i = 1; i < count; i++) {
+        WorkQueue& queue = *queues[(self + i) % count];
+        lock_guard<mutex> guard(queue.lock);
+        if (!queue.jobs.empty()) {
+            job = move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queued.fetch_sub(1, memory_order_relaxed);
+            stolen.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::tryRunOne()
+{
+    if (queued.load(memory_order_acquire) == 0) return false;
+
+    Job job;
+    if (!takeJob(job)) return false;
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(Job& job)
+{
+    job.task();
+    executed.fetch_add(1, memory_order_relaxed);
+    finish(job.counter);
+}
+
+void JobSystem::finish(JobCounter* counter)
+{
+    if (counter == nullptr) return;
+
+    // Zerar o contador é a última coisa feita nele, sob a trava: wait() passa
+    // pela mesma trava antes de voltar, então quem esperava só destrói o
+    // contador depois que este job o soltou
+    vector<JobCounter::Continuation> ready;
+    {
+        lock_guard<mutex> guard(counter->lock);
+        if (counter->pending.fetch_sub(1, memory_order_acq_rel) != 1) return;
+        ready.swap(counter->continuations);
+    }
+
+    // Último job do grupo: libera as continuações (o contador delas já foi somado)
+    for (JobCounter::Continuation& continuation : ready) {
+        push({move(continuation.task), continuation.counter});
+    }
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    // Quem espera só ajuda com os jobs do próprio grupo: um tick da simulação
+    // esperando um parallelFor não pega, por exemplo, a decodificação de um PNG
+    while (!counter.isDone()) {
+        Job job;
+        if (queued.load(memory_order_acquire) > 0 && takeJobOf(counter, job)) {
+            execute(job);
+        } else {
+            this_thread::yield();
+        }
+    }
+
+    // O job que zerou o contador ainda pode estar dentro de finish()
+    lock_guard<mutex> guard(counter.lock);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const function<void(size_t, size_t)>& body)
+{
+    if (count == 0) return;
+    grain = max<size_t>(1, grain);
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || workers.empty()) {
+        body(0, count);
+        return;
+    }
+
+    // A thread que chamou fica com o primeiro bloco e ajuda nos outros
+    JobCounter counter;
+    for (size_t chunk = 1; chunk < chunks; chunk++) {
+        size_t begin = chunk * grain;
+        size_t end = min(count, begin + grain);
+        run([&body, begin, end]() { body(begin, end); }, &counter);
+    }
+    body(0, grain);
+    wait(counter);
+}
+
+JobSystemStats JobSystem::getStats() const
+{
+    JobSystemStats stats;
+    stats.workers = (int)workers.size();
+    stats.executed = executed.load(memory_order_relaxed);
+    stats.stolen = stolen.load(memory_order_relaxed);
+    return stats;
+}
+
+void JobSystem::workerLoop(int queueIndex)
+{
+    workerOwner = this;
+    workerQueue = queueIndex;
+
+    for (;;) {
+        if (tryRunOne()) continue;
+
+        unique_lock<mutex> guard(sleepLock);
+        if (stopping) return;
+        wake.wait(guard, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+    }
+}
@@ -0,0 +1,129 @@
+#include "MotionBuffer.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+MotionBuffer::MotionBuffer() : bufferId(0), textureId(0), slotCapacity(0), count(0), uploadedBytes(0)
+{
+}
+
+MotionBuffer::~MotionBuffer()
+{
+    // Os objetos GL são apagados em destroy(), com o contexto ainda ativo
+}
+
+bool MotionBuffer::initialize(int capacity)
+{
+    glGenBuffers(1, &bufferId);
+    glGenTextures(1, &textureId);
+    if (bufferId == 0 || textureId == 0) {
+        cerr << "Falha ao criar o buffer de movimento" << endl;
+        destroy();
+        return false;
+    }
+    return grow(max(1, capacity));
+}
+
+void MotionBuffer::destroy()
+{
+    if (textureId != 0) glDeleteTextures(1, &textureId);
+    if (bufferId != 0) glDeleteBuffers(1, &bufferId);
+    textureId = 0;
+    bufferId = 0;
+    data.clear();
+    freeSlots.clear();
+    slotCapacity = 0;
+    count = 0;
+}
+
+bool MotionBuffer::grow(int capacity)
+{
+    data.resize((size_t)capacity * MOTION_TEXELS * 4, 0.0f);
+
+    size_t bytes = data.size() * sizeof(float);
+    glBindBuffer(GL_TEXTURE_BUFFER, bufferId);
+    glBufferData(GL_TEXTURE_BUFFER, bytes, data.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    uploadedBytes += bytes;
+
+    // A textura de buffer aponta para o armazenamento novo (o alvo
+    // GL_TEXTURE_BUFFER não interfere nas texturas 2D da unidade ativa)
+    glBindTexture(GL_TEXTURE_BUFFER, textureId);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, bufferId);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        cerr << "Falha ao alocar o buffer de movimento (" << capacity << " objetos)" << endl;
+        return false;
+    }
+    return true;
+}
+
+int MotionBuffer::allocate()
+{
+    if (!isReady()) return -1;
+
+    if (freeSlots.empty()) {
+        // Slots novos entram na lista livre do maior para o menor: os menores saem primeiro
+        int newCapacity = max(256, slotCapacity * 2);
+        for (int slot = newCapacity - 1; slot >= slotCapacity; slot--) {
+            freeSlots.push_back(slot);
+        }
+        slotCapacity = newCapacity;
+    }
+
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    count++;
+    return slot;
+}
+
+void MotionBuffer::remove(int slot)
+{
+    if (slot < 0 || slot >= slotCapacity) return;
+    freeSlots.push_back(slot);
+    count--;
+}
+
+void MotionBuffer::clear()
+{
+    freeSlots.clear();
+    for (int slot = slotCapacity - 1; slot >= 0; slot--) {
+        freeSlots.push_back(slot);
+    }
+    count = 0;
+}
+
+bool MotionBuffer::write(int slot, const MotionParams& motion)
+{
+    if (!isReady() || slot < 0) return false;
+    if (slot >= getCapacity()) {
+        int capacity = max(1, getCapacity());
+        while (capacity <= slot) capacity *= 2;
+        if (!grow(capacity)) return false;
+    }
+
+    // Mesma ordem lida pelo vertex shader
+    float values[MOTION_TEXELS * 4] = {
+        motion.spawnPos.x, motion.spawnPos.y, motion.velocity.x, motion.velocity.y,
+        motion.spawnTime, motion.spawnAngle, motion.rotationSpeed, motion.spawnPos.z,
+        motion.size.x, motion.size.y, motion.size.z, 0.0f
+    };
+    float* texels = &data[(size_t)slot * MOTION_TEXELS * 4];
+    if (memcmp(texels, values, sizeof(values)) == 0) return true;
+    copy(values, values + MOTION_TEXELS * 4, texels);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, bufferId);
+    glBufferSubData(GL_TEXTURE_BUFFER, (GLintptr)slot * sizeof(values), sizeof(values), texels);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    uploadedBytes += sizeof(values);
+    return true;
+}
+
+void MotionBuffer::bind(GLuint unit) const
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, textureId);
+    glActiveTexture(GL_TEXTURE0);
+}
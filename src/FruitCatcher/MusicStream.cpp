@@ -0,0 +1,387 @@
+#include "MusicStream.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+MusicStream::MusicStream()
+    : channels(0), sampleRate(0), pageFrames(0), opened(false),
+      running(false), looping(true), reachedEnd(false),
+      seekRequest(NO_SEEK), framesWritten(0), discardUntil(0), readCursor(0),
+      underruns(0), underrunFrames(0), pagesDecoded(0),
+      decodeNanosTotal(0), decodeNanosMax(0), decodeNanosLast(0), minFillFrames(0)
+{
+    memset(&source, 0, sizeof(source));
+}
+
+MusicStream::~MusicStream()
+{
+    close();
+}
+
+bool MusicStream::open(const string& filePath, ma_uint32 outChannels, ma_uint32 outSampleRate,
+                       const MusicStreamConfig& streamConfig, const ma_allocation_callbacks* allocationCallbacks)
+{
+    close();
+    prepare(outChannels, outSampleRate, streamConfig);
+
+    // Decodifica direto no formato do motor, sem conversão no mixer
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+    if (allocationCallbacks != nullptr) decoderConfig.allocationCallbacks = *allocationCallbacks;
+    if (ma_decoder_init_file(filePath.c_str(), &decoderConfig, &decoder) != MA_SUCCESS) {
+        return false;
+    }
+    return start(allocationCallbacks);
+}
+
+bool MusicStream::open(const void* encodedData, size_t encodedSize, ma_uint32 outChannels, ma_uint32 outSampleRate,
+                       const MusicStreamConfig& streamConfig, const ma_allocation_callbacks* allocationCallbacks)
+{
+    close();
+    prepare(outChannels, outSampleRate, streamConfig);
+
+    // Os dados precisam continuar válidos enquanto o stream estiver aberto
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+    if (allocationCallbacks != nullptr) decoderConfig.allocationCallbacks = *allocationCallbacks;
+    if (ma_decoder_init_memory(encodedData, encodedSize, &decoderConfig, &decoder) != MA_SUCCESS) {
+        return false;
+    }
+    return start(allocationCallbacks);
+}
+
+void MusicStream::prepare(ma_uint32 outChannels, ma_uint32 outSampleRate, const MusicStreamConfig& streamConfig)
+{
+    config = streamConfig;
+    if (config.pageSizeMs < 10) config.pageSizeMs = 10;
+    if (config.pageCount < 2) config.pageCount = 2;
+
+    channels = outChannels;
+    sampleRate = outSampleRate;
+    pageFrames = (ma_uint32)((ma_uint64)sampleRate * config.pageSizeMs / 1000);
+}
+
+bool MusicStream::start(const ma_allocation_callbacks* allocationCallbacks)
+{
+    if (ma_pcm_rb_init(ma_format_f32, channels, pageFrames * config.pageCount, NULL,
+                       allocationCallbacks, &ringBuffer) != MA_SUCCESS) {
+        ma_decoder_uninit(&decoder);
+        return false;
+    }
+
+    static const ma_data_source_vtable vtable = {
+        onRead, onSeek, onGetDataFormat, onGetCursor, onGetLength, onSetLooping, 0
+    };
+    ma_data_source_config sourceConfig = ma_data_source_config_init();
+    sourceConfig.vtable = &vtable;
+    if (ma_data_source_init(&sourceConfig, &source.base) != MA_SUCCESS) {
+        ma_pcm_rb_uninit(&ringBuffer);
+        ma_decoder_uninit(&decoder);
+        return false;
+    }
+    source.owner = this;
+
+    seekRequest = NO_SEEK;
+    framesWritten = 0;
+    discardUntil = 0;
+    readCursor = 0;
+    reachedEnd = false;
+
+    opened = true;
+    resetStats();
+    startThread();
+
+    cout << "Streaming da música: páginas de " << config.pageSizeMs << " ms x " << config.pageCount
+         << " (prefetch de " << config.pageSizeMs * config.pageCount << " ms)" << endl;
+    return true;
+}
+
+void MusicStream::close()
+{
+    if (!opened) return;
+
+    stopThread();
+    ma_data_source_uninit(&source.base);
+    ma_pcm_rb_uninit(&ringBuffer);
+    ma_decoder_uninit(&decoder);
+    opened = false;
+}
+
+void MusicStream::rewind()
+{
+    if (!opened) return;
+
+    // Resetar o buffer daqui disputaria com o callback de áudio, que pode ainda
+    // estar lendo mesmo com o som parado: a thread de decodificação aplica a busca
+    seekRequest = 0;
+}
+
+void MusicStream::startThread()
+{
+    // Prefetch síncrono: o buffer começa cheio, então o nível mínimo medido
+    // reflete só o comportamento em regime
+    while (ma_pcm_rb_available_write(&ringBuffer) >= pageFrames && decodePage()) {
+    }
+    minFillFrames = ma_pcm_rb_available_read(&ringBuffer);
+
+    running = true;
+    decodeThread = thread(&MusicStream::decodeLoop, this);
+}
+
+void MusicStream::stopThread()
+{
+    running = false;
+    if (decodeThread.joinable()) {
+        decodeThread.join();
+    }
+}
+
+void MusicStream::resetStats()
+{
+    underruns = 0;
+    underrunFrames = 0;
+    pagesDecoded = 0;
+    decodeNanosTotal = 0;
+    decodeNanosMax = 0;
+    decodeNanosLast = 0;
+}
+
+bool MusicStream::decodePage()
+{
+    if (reachedEnd) return false;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    ma_uint32 remaining = pageFrames;
+    bool rewound = false; // voltou ao início sem ler nada desde então
+    while (remaining > 0) {
+        // O ring buffer pode devolver menos que o pedido ao dar a volta
+        ma_uint32 chunk = remaining;
+        void* buffer = nullptr;
+        if (ma_pcm_rb_acquire_write(&ringBuffer, &chunk, &buffer) != MA_SUCCESS || chunk == 0) break;
+
+        ma_uint64 framesRead = 0;
+        ma_result result = ma_decoder_read_pcm_frames(&decoder, buffer, chunk, &framesRead);
+        ma_pcm_rb_commit_write(&ringBuffer, (ma_uint32)framesRead);
+        framesWritten += framesRead;
+        remaining -= (ma_uint32)framesRead;
+        if (framesRead > 0) rewound = false;
+
+        if (framesRead < chunk) {
+            if (framesRead == 0 && (rewound || (result != MA_SUCCESS && result != MA_AT_END))) {
+                // Nada lido logo após voltar ao início, ou erro do decodificador:
+                // encerra a música em vez de tentar de novo para sempre
+                cerr << "Erro ao decodificar a música: o decodificador não devolveu frames" << endl;
+                reachedEnd = true;
+            } else if (looping) {
+                ma_decoder_seek_to_pcm_frame(&decoder, 0);
+                rewound = true;
+            } else {
+                reachedEnd = true;
+            }
+        }
+        if (reachedEnd) break;
+    }
+
+    unsigned long long nanos = (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count();
+    decodeNanosLast = nanos;
+    decodeNanosTotal += nanos;
+    if (nanos > decodeNanosMax) decodeNanosMax = nanos;
+    pagesDecoded++;
+
+    return !reachedEnd;
+}
+
+void MusicStream::applySeek()
+{
+    ma_uint64 target = seekRequest.exchange(NO_SEEK);
+    if (target == NO_SEEK) return;
+
+    if (ma_decoder_seek_to_pcm_frame(&decoder, target) != MA_SUCCESS) {
+        cerr << "Aviso: não foi possível buscar o frame " << target << " da música" << endl;
+        return;
+    }
+    // Tudo o que já está no buffer é da posição antiga: o mixer pula até aqui
+    discardUntil = framesWritten.load();
+    reachedEnd = false;
+}
+
+void MusicStream::decodeLoop()
+{
+    if (!setCurrentThreadPriority(config.decodePriority)) {
+        cerr << "Aviso: não foi possível ajustar a prioridade da thread de decodificação" << endl;
+    }
+
+    // Acorda algumas vezes por página para manter o buffer cheio
+    chrono::milliseconds idle(config.pageSizeMs / 4 > 0 ? config.pageSizeMs / 4 : 1);
+
+    while (running) {
+        applySeek();
+        if (!reachedEnd && ma_pcm_rb_available_write(&ringBuffer) >= pageFrames) {
+            decodePage();
+        } else {
+            this_thread::sleep_for(idle);
+        }
+    }
+}
+
+MusicStreamStats MusicStream::getStats() const
+{
+    MusicStreamStats stats;
+    stats.underruns = underruns;
+    stats.underrunFrames = underrunFrames;
+    stats.pagesDecoded = pagesDecoded;
+    stats.lastPageDecodeMs = decodeNanosLast / 1.0e6;
+    stats.maxPageDecodeMs = decodeNanosMax / 1.0e6;
+    stats.avgPageDecodeMs = pagesDecoded > 0 ? (decodeNanosTotal / 1.0e6) / pagesDecoded : 0.0;
+    if (sampleRate > 0) {
+        stats.minFillMs = minFillFrames * 1000.0 / sampleRate;
+        stats.capacityMs = (double)pageFrames * config.pageCount * 1000.0 / sampleRate;
+    }
+    return stats;
+}
+
+// ===== DATA SOURCE (thread do mixer) =====
+
+ma_result MusicStream::onRead(ma_data_source* dataSource, void* framesOut, ma_uint64 frameCount, ma_uint64* framesRead)
+{
+    MusicStream* self = ((Source*)dataSource)->owner;
+    float* out = (float*)framesOut;
+
+    // Pula o que foi decodificado antes de uma busca (só o mixer avança a leitura)
+    ma_uint64 discardTarget = self->discardUntil;
+    while (self->readCursor < discardTarget) {
+        ma_uint32 chunk = (ma_uint32)(discardTarget - self->readCursor); // no máximo a capacidade do buffer
+        void* buffer = nullptr;
+        if (ma_pcm_rb_acquire_read(&self->ringBuffer, &chunk, &buffer) != MA_SUCCESS || chunk == 0) break;
+        ma_pcm_rb_commit_read(&self->ringBuffer, chunk);
+        self->readCursor += chunk;
+    }
+
+    ma_uint32 available = ma_pcm_rb_available_read(&self->ringBuffer);
+    if (available < self->minFillFrames) self->minFillFrames = available;
+
+    ma_uint64 total = 0;
+    while (total < frameCount) {
+        ma_uint32 chunk = (ma_uint32)(frameCount - total);
+        void* buffer = nullptr;
+        if (ma_pcm_rb_acquire_read(&self->ringBuffer, &chunk, &buffer) != MA_SUCCESS || chunk == 0) break;
+
+        memcpy(out + total * self->channels, buffer, (size_t)chunk * self->channels * sizeof(float));
+        ma_pcm_rb_commit_read(&self->ringBuffer, chunk);
+        self->readCursor += chunk;
+        total += chunk;
+    }
+
+    if (total < frameCount) {
+        if (self->reachedEnd) {
+            // Fim real da música (sem loop)
+            *framesRead = total;
+            return total == 0 ? MA_AT_END : MA_SUCCESS;
+        }
+
+        // Underrun: completa com silêncio para o som continuar tocando
+        memset(out + total * self->channels, 0, (size_t)(frameCount - total) * self->channels * sizeof(float));
+        self->underruns++;
+        self->underrunFrames += frameCount - total;
+    }
+
+    *framesRead = frameCount;
+    return MA_SUCCESS;
+}
+
+ma_result MusicStream::onSeek(ma_data_source* dataSource, ma_uint64 frameIndex)
+{
+    // Chamado pelo miniaudio na thread do mixer (ex.: ao dar a volta no loop):
+    // o decodificador não é dele, então só registra o pedido para a thread de decodificação
+    ((Source*)dataSource)->owner->seekRequest = frameIndex;
+    return MA_SUCCESS;
+}
+
+ma_result MusicStream::onGetDataFormat(ma_data_source* dataSource, ma_format* format, ma_uint32* outChannels,
+                                       ma_uint32* outSampleRate, ma_channel* channelMap, size_t channelMapCap)
+{
+    MusicStream* self = ((Source*)dataSource)->owner;
+    *format = ma_format_f32;
+    *outChannels = self->channels;
+    *outSampleRate = self->sampleRate;
+    ma_channel_map_init_standard(ma_standard_channel_map_default, channelMap, channelMapCap, self->channels);
+    return MA_SUCCESS;
+}
+
+ma_result MusicStream::onGetCursor(ma_data_source* dataSource, ma_uint64* cursor)
+{
+    (void)dataSource;
+    *cursor = 0;
+    return MA_NOT_IMPLEMENTED;
+}
+
+ma_result MusicStream::onGetLength(ma_data_source* dataSource, ma_uint64* length)
+{
+    (void)dataSource;
+    *length = 0; // stream sem tamanho conhecido (pode estar em loop)
+    return MA_NOT_IMPLEMENTED;
+}
+
+ma_result MusicStream::onSetLooping(ma_data_source* dataSource, ma_bool32 isLooping)
+{
+    ((Source*)dataSource)->owner->setLooping(isLooping == MA_TRUE);
+    return MA_SUCCESS;
+}
+
+// ===== PRIORIDADE DE THREAD =====
+
+bool setCurrentThreadPriority(ThreadPriority priority)
+{
+#ifdef _WIN32
+    int level = THREAD_PRIORITY_NORMAL;
+    if (priority == THREAD_PRIORITY_LOW_LEVEL) level = THREAD_PRIORITY_BELOW_NORMAL;
+    if (priority == THREAD_PRIORITY_HIGH_LEVEL) level = THREAD_PRIORITY_HIGHEST;
+    return SetThreadPriority(GetCurrentThread(), level) != 0;
+#else
+    if (priority == THREAD_PRIORITY_NORMAL_LEVEL) return true;
+
+    if (priority == THREAD_PRIORITY_HIGH_LEVEL) {
+        // Tempo real com a menor prioridade da classe; pode exigir permissão
+        sched_param param;
+        param.sched_priority = sched_get_priority_min(SCHED_RR);
+        if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0) return true;
+    }
+
+#ifdef __linux__
+    // No Linux o nice vale por thread
+    int niceValue = (priority == THREAD_PRIORITY_HIGH_LEVEL) ? -5 : 10;
+    return setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), niceValue) == 0;
+#else
+    return false;
+#endif
+#endif
+}
+
+ThreadPriority parseThreadPriority(const string& text)
+{
+    if (text == "LOW" || text == "low") return THREAD_PRIORITY_LOW_LEVEL;
+    if (text == "HIGH" || text == "high") return THREAD_PRIORITY_HIGH_LEVEL;
+    if (text != "NORMAL" && text != "normal") {
+        cerr << "Aviso: prioridade de thread desconhecida '" << text << "', usando NORMAL" << endl;
+    }
+    return THREAD_PRIORITY_NORMAL_LEVEL;
+}
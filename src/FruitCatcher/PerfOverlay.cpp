@@ -0,0 +1,80 @@
+#include "PerfOverlay.h"
+
+#include <sstream>
+#include <iomanip>
+
+static const double REFRESH_INTERVAL = 0.5; // segundos entre atualizações do título
+
+PerfOverlay::PerfOverlay()
+    : window(nullptr), enabled(false), frames(0), accumulatedTime(0.0f),
+      fps(0.0f), avgFrameMs(0.0f), maxFrameMs(0.0f), lastRefresh(0.0)
+{
+}
+
+void PerfOverlay::initialize(GLFWwindow* window, const string& baseTitle, bool enabled)
+{
+    this->window = window;
+    this->baseTitle = baseTitle;
+    this->enabled = enabled;
+    lastRefresh = glfwGetTime();
+}
+
+void PerfOverlay::toggle()
+{
+    enabled = !enabled;
+    if (window == nullptr) return;
+
+    if (enabled) {
+        refreshTitle();
+    } else {
+        glfwSetWindowTitle(window, baseTitle.c_str()); // Restaura o título original
+    }
+}
+
+void PerfOverlay::frame(float deltaTime)
+{
+    frames++;
+    accumulatedTime += deltaTime;
+    if (deltaTime * 1000.0f > maxFrameMs) maxFrameMs = deltaTime * 1000.0f;
+}
+
+void PerfOverlay::set(const string& name, const string& value)
+{
+    for (auto& entry : values) {
+        if (entry.first == name) {
+            entry.second = value;
+            return;
+        }
+    }
+    values.push_back(make_pair(name, value));
+}
+
+void PerfOverlay::update()
+{
+    double time = glfwGetTime();
+    if (time - lastRefresh < REFRESH_INTERVAL) return;
+    lastRefresh = time;
+
+    // Médias da janela que acabou de fechar
+    fps = accumulatedTime > 0.0f ? frames / accumulatedTime : 0.0f;
+    avgFrameMs = frames > 0 ? accumulatedTime * 1000.0f / frames : 0.0f;
+
+    if (enabled && window != nullptr) {
+        refreshTitle();
+    }
+
+    frames = 0;
+    accumulatedTime = 0.0f;
+    maxFrameMs = 0.0f;
+}
+
+void PerfOverlay::refreshTitle()
+{
+    ostringstream title;
+    title << fixed << setprecision(1);
+    title << baseTitle << " | " << fps << " FPS | frame " << avgFrameMs << " ms (máx " << maxFrameMs << ")";
+    for (const auto& entry : values) {
+        title << " | " << entry.first << " " << entry.second;
+    }
+    glfwSetWindowTitle(window, title.str().c_str());
+}
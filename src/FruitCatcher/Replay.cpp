@@ -0,0 +1,135 @@
+#include "Replay.h"
+#include "FileUtils.h"
+
+#include <iostream>
+#include <cstring>
+
+static const char REPLAY_MAGIC[8] = {'F', 'C', 'R', 'E', 'P', 'L', 'A', 'Y'};
+static const uint32_t REPLAY_VERSION = 1;
+
+static void appendBytes(vector<unsigned char>& data, const void* bytes, size_t size)
+{
+    const unsigned char* begin = (const unsigned char*)bytes;
+    data.insert(data.end(), begin, begin + size);
+}
+
+ReplayWriter::ReplayWriter() : recording(false), eventCount(0)
+{
+}
+
+void ReplayWriter::begin(const ReplayHeader& header, const vector<int>& downKeys)
+{
+    ReplayHeader fileHeader = header;
+    memcpy(fileHeader.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    fileHeader.version = REPLAY_VERSION;
+    fileHeader.downKeyCount = (uint32_t)downKeys.size();
+
+    data.clear();
+    eventCount = 0;
+    appendBytes(data, &fileHeader, sizeof(fileHeader));
+    for (int key : downKeys) {
+        int32_t value = key;
+        appendBytes(data, &value, sizeof(value));
+    }
+    recording = true;
+}
+
+void ReplayWriter::record(uint32_t tick, const vector<TickInput>& events)
+{
+    if (!recording) return;
+    for (const TickInput& event : events) {
+        ReplayRecord record = {tick, event.type, event.code, event.fraction, event.x};
+        appendBytes(data, &record, sizeof(record));
+        eventCount++;
+    }
+}
+
+bool ReplayWriter::finish(const string& filePath, uint32_t tick, int score, int lives)
+{
+    if (!recording) return false;
+    recording = false;
+
+    ReplayRecord end = {tick, REPLAY_END, score, 0.0f, (float)lives};
+    appendBytes(data, &end, sizeof(end));
+
+    if (!writeFileAtomic(filePath, data.data(), data.size())) {
+        cerr << "Replay: erro ao gravar " << filePath << endl;
+        return false;
+    }
+    cout << "Replay gravado: " << filePath << " (" << tick << " ticks, "
+         << eventCount << " eventos)" << endl;
+    return true;
+}
+
+ReplayReader::ReplayReader() : cursor(0), endTick(0), finalScore(0), finalLives(0)
+{
+    memset(&header, 0, sizeof(header));
+}
+
+bool ReplayReader::load(const string& filePath)
+{
+    vector<unsigned char> fileData;
+    if (!readFile(filePath, fileData)) {
+        cerr << "Replay: não foi possível ler " << filePath << endl;
+        return false;
+    }
+
+    if (fileData.size() < sizeof(header)) {
+        cerr << "Replay: arquivo truncado: " << filePath << endl;
+        return false;
+    }
+    memcpy(&header, fileData.data(), sizeof(header));
+    if (memcmp(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 || header.version != REPLAY_VERSION) {
+        cerr << "Replay: formato desconhecido: " << filePath << endl;
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    size_t keysSize = (size_t)header.downKeyCount * sizeof(int32_t);
+    if (offset + keysSize > fileData.size()) {
+        cerr << "Replay: arquivo truncado: " << filePath << endl;
+        return false;
+    }
+    downKeys.clear();
+    for (uint32_t i = 0; i < header.downKeyCount; i++) {
+        int32_t key;
+        memcpy(&key, fileData.data() + offset, sizeof(key));
+        downKeys.push_back(key);
+        offset += sizeof(key);
+    }
+
+    records.clear();
+    bool ended = false;
+    while (offset + sizeof(ReplayRecord) <= fileData.size()) {
+        ReplayRecord record;
+        memcpy(&record, fileData.data() + offset, sizeof(record));
+        offset += sizeof(record);
+        if (record.type == REPLAY_END) {
+            endTick = record.tick;
+            finalScore = record.code;
+            finalLives = (int)record.x;
+            ended = true;
+            break;
+        }
+        records.push_back(record);
+    }
+    if (!ended) {
+        cerr << "Replay: sem registro final (partida interrompida?): " << filePath << endl;
+        return false;
+    }
+
+    cursor = 0;
+    cout << "Replay carregado: " << filePath << " (" << endTick << " ticks, "
+         << records.size() << " eventos)" << endl;
+    return true;
+}
+
+void ReplayReader::eventsForTick(uint32_t tick, vector<TickInput>& out)
+{
+    while (cursor < records.size() && records[cursor].tick <= tick) {
+        const ReplayRecord& record = records[cursor++];
+        if (record.tick < tick) continue;
+        TickInput event = {record.type, record.code, record.fraction, record.x};
+        out.push_back(event);
+    }
+}
@@ -0,0 +1,195 @@
+#include "ShaderCache.h"
+#include "GLExtensions.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+static const char SHADER_CACHE_MAGIC[8] = {'F', 'C', 'S', 'H', 'A', 'D', 'E', 'R'};
+static const uint32_t SHADER_CACHE_VERSION = 1;
+
+ShaderCache::ShaderCache() : directory("cache/shaders")
+{
+}
+
+void ShaderCache::setDirectory(const string& dir)
+{
+    directory = dir;
+}
+
+static uint64_t hashString(const char* text, uint64_t seed = 14695981039346656037ULL)
+{
+    if (text == nullptr) return seed;
+    // O terminador entra no hash para separar campos consecutivos
+    return hashBytes(text, strlen(text) + 1, seed);
+}
+
+uint64_t ShaderCache::keyFor(const char* vertexSource, const char* fragmentSource) const
+{
+    uint64_t key = hashString(vertexSource);
+    key = hashString(fragmentSource, key);
+    key = hashString((const char*)glGetString(GL_VENDOR), key);
+    key = hashString((const char*)glGetString(GL_RENDERER), key);
+    key = hashString((const char*)glGetString(GL_VERSION), key);
+    return key;
+}
+
+string ShaderCache::cachePathFor(uint64_t key) const
+{
+    return directory + "/" + hashToHex(key) + ".bin";
+}
+
+GLuint ShaderCache::loadProgram(const char* vertexSource, const char* fragmentSource)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    if (!glExtensions.programBinary) {
+        GLuint program = compileProgram(vertexSource, fragmentSource, false);
+        stats.misses++;
+        stats.lastLoadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        return program;
+    }
+
+    uint64_t key = keyFor(vertexSource, fragmentSource);
+    string cachePath = cachePathFor(key);
+
+    // Caminho rápido: binário do mesmo driver, sem compilar nada
+    GLuint program = loadBinary(cachePath, key);
+    if (program != 0) {
+        stats.hits++;
+        stats.lastLoadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "Shader carregado do cache: " << cachePath << " (" << stats.lastLoadMs << " ms)" << endl;
+        return program;
+    }
+
+    // Primeira execução (ou binário recusado): compila e grava
+    program = compileProgram(vertexSource, fragmentSource, true);
+    stats.misses++;
+    if (program != 0) {
+        saveBinary(program, cachePath, key);
+    }
+    stats.lastLoadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Shader compilado em " << stats.lastLoadMs << " ms" << endl;
+    return program;
+}
+
+GLuint ShaderCache::loadBinary(const string& cachePath, uint64_t key)
+{
+    vector<unsigned char> fileData;
+    if (!readFile(cachePath, fileData)) return 0;
+
+    ShaderCacheHeader header;
+    if (fileData.size() < sizeof(header)) return 0;
+    memcpy(&header, fileData.data(), sizeof(header));
+
+    bool valid = memcmp(header.magic, SHADER_CACHE_MAGIC, sizeof(SHADER_CACHE_MAGIC)) == 0 &&
+                 header.version == SHADER_CACHE_VERSION &&
+                 header.key == key &&
+                 header.binaryLength > 0 &&
+                 sizeof(header) + header.binaryLength <= fileData.size();
+    if (!valid) return 0;
+
+    GLuint program = glCreateProgram();
+    glExtensions.programBinaryLoad(program, (GLenum)header.binaryFormat,
+                                   fileData.data() + sizeof(header), (GLsizei)header.binaryLength);
+
+    // O driver pode recusar um binário válido (ex.: atualização sem mudar GL_VERSION)
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        remove(cachePath.c_str());
+        stats.rejected++;
+        cout << "Cache de shaders: binário recusado pelo driver, recompilando" << endl;
+        return 0;
+    }
+    return program;
+}
+
+void ShaderCache::saveBinary(GLuint program, const string& cachePath, uint64_t key)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    if (!createDirectories(directory)) {
+        cerr << "Cache de shaders: não foi possível criar " << directory << endl;
+        return;
+    }
+
+    ShaderCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SHADER_CACHE_MAGIC, sizeof(SHADER_CACHE_MAGIC));
+    header.version = SHADER_CACHE_VERSION;
+    header.key = key;
+
+    vector<unsigned char> fileData(sizeof(header) + length, 0);
+    GLsizei written = 0;
+    GLenum binaryFormat = 0;
+    glExtensions.getProgramBinary(program, length, &written, &binaryFormat, fileData.data() + sizeof(header));
+    if (written <= 0) return;
+
+    header.binaryFormat = binaryFormat;
+    header.binaryLength = (uint64_t)written;
+    memcpy(fileData.data(), &header, sizeof(header));
+    fileData.resize(sizeof(header) + written);
+
+    if (!writeFileAtomic(cachePath, fileData.data(), fileData.size())) {
+        cerr << "Cache de shaders: erro ao gravar " << cachePath << endl;
+        return;
+    }
+    cout << "Cache de shaders criado: " << cachePath << endl;
+}
+
+GLuint ShaderCache::compileProgram(const char* vertexSource, const char* fragmentSource, bool retrievable)
+{
+    // Vertex shader
+    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vertexSource, NULL);
+    glCompileShader(vertexShader);
+
+    GLint success;
+    GLchar infoLog[512];
+    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
+        cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << endl;
+    }
+
+    // Fragment shader
+    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
+    glCompileShader(fragmentShader);
+
+    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
+        cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << endl;
+    }
+
+    // Linkar programa (pedindo ao driver para manter o binário recuperável)
+    GLuint shaderProgram = glCreateProgram();
+    if (retrievable) {
+        glExtensions.programParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+    glLinkProgram(shaderProgram);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+        cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << endl;
+        glDeleteProgram(shaderProgram);
+        return 0;
+    }
+
+    return shaderProgram;
+}
@@ -0,0 +1,307 @@
+#include "SharedAssetCache.h"
+#include "FileUtils.h"
+#include "AssetPack.h"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#endif
+
+static const char SHARED_CACHE_MAGIC[8] = {'F', 'C', 'S', 'H', 'A', 'R', 'E', 'D'};
+static const uint32_t SHARED_CACHE_VERSION = 1;
+static const uint64_t SHARED_CACHE_ALIGNMENT = 64;
+
+static uint64_t alignUp(uint64_t value)
+{
+    return (value + SHARED_CACHE_ALIGNMENT - 1) / SHARED_CACHE_ALIGNMENT * SHARED_CACHE_ALIGNMENT;
+}
+
+uint64_t sharedImageKey(const string& filePath, int maxWidth, int maxHeight)
+{
+    error_code ec;
+    uint64_t size = (uint64_t)filesystem::file_size(filePath, ec);
+    if (ec) return 0;
+    uint64_t modified = (uint64_t)filesystem::last_write_time(filePath, ec).time_since_epoch().count();
+    if (ec) return 0;
+
+    string path = normalizeAssetPath(filePath);
+    uint64_t parts[4] = { size, modified, (uint64_t)maxWidth, (uint64_t)maxHeight };
+    return hashBytes(parts, sizeof(parts), hashBytes(path.data(), path.size()));
+}
+
+uint64_t sharedPackedKey(uint64_t sourceHash, int firstLevel)
+{
+    uint64_t parts[3] = { sourceHash, (uint64_t)firstLevel, 0x42433752ULL }; // "BC7R": descomprimida
+    return hashBytes(parts, sizeof(parts));
+}
+
+SharedAssetCache::SharedAssetCache()
+    : key(0), header(nullptr), entries(nullptr), mappedSize(0), recording(false)
+{
+}
+
+SharedAssetCache::~SharedAssetCache()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool SharedAssetCache::open(uint64_t)
+{
+    cout << "Cache compartilhado de assets: disponível só em sistemas POSIX" << endl;
+    return false;
+}
+
+void SharedAssetCache::close()
+{
+    recording = false;
+    pending.clear();
+}
+
+bool SharedAssetCache::attach()
+{
+    return false;
+}
+
+bool SharedAssetCache::publish()
+{
+    return false;
+}
+
+#else
+
+// Processo criador ainda vivo? (segmento incompleto de quem morreu é lixo)
+static bool processAlive(uint64_t pid)
+{
+    return pid != 0 && (kill((pid_t)pid, 0) == 0 || errno == EPERM);
+}
+
+bool SharedAssetCache::open(uint64_t packHash)
+{
+    close();
+
+    // Um segmento por usuário: o de outro usuário nunca é aceito (ver attach)
+    uint64_t parts[2] = { packHash, SHARED_CACHE_VERSION };
+    key = hashBytes(parts, sizeof(parts));
+    name = "/fruitcatcher-" + to_string((unsigned long)geteuid()) + "-" + hashToHex(key);
+
+    if (attach()) {
+        cout << "Cache compartilhado de assets: " << name << " (" << header->entryCount << " texturas, "
+             << mappedSize / 1024 << " KB, somente leitura)" << endl;
+        return true;
+    }
+
+    // Ninguém publicou ainda: este processo decodifica e publica
+    recording = true;
+    cout << "Cache compartilhado de assets: " << name << " ainda não existe, será criado após o carregamento" << endl;
+    return false;
+}
+
+bool SharedAssetCache::attach()
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    // O nome é previsível: só confia num segmento criado por este usuário e
+    // que ninguém mais pode alterar
+    if (info.st_uid != geteuid() || (info.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+        ::close(fd);
+        cerr << "Cache compartilhado de assets: " << name << " pertence a outro usuário ou é gravável por outros, ignorado" << endl;
+        return false;
+    }
+    if ((size_t)info.st_size < sizeof(SharedCacheHeader)) {
+        ::close(fd); // outro processo está criando agora
+        return false;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    const SharedCacheHeader* candidate = static_cast<const SharedCacheHeader*>(view);
+    uint32_t ready = __atomic_load_n(&candidate->ready, __ATOMIC_ACQUIRE);
+    bool valid = memcmp(candidate->magic, SHARED_CACHE_MAGIC, sizeof(SHARED_CACHE_MAGIC)) == 0 &&
+                 candidate->version == SHARED_CACHE_VERSION &&
+                 candidate->key == key &&
+                 ready == 1 &&
+                 candidate->totalSize <= size &&
+                 sizeof(SharedCacheHeader) + (uint64_t)candidate->entryCount * sizeof(SharedImageEntry) <= size;
+
+    // O segmento também é uma entrada não confiável: cada imagem precisa caber
+    // nele com exatamente os bytes da sua cadeia RGBA, e o índice precisa estar
+    // ordenado pela chave (find() usa busca binária)
+    if (valid) {
+        const SharedImageEntry* table = reinterpret_cast<const SharedImageEntry*>(candidate + 1);
+        uint64_t tableEnd = sizeof(SharedCacheHeader) + (uint64_t)candidate->entryCount * sizeof(SharedImageEntry);
+        for (uint32_t i = 0; i < candidate->entryCount && valid; i++) {
+            const SharedImageEntry& entry = table[i];
+            uint64_t expected = 0;
+            valid = entry.dataOffset >= tableEnd &&
+                    entry.dataOffset <= size && entry.dataSize <= size - entry.dataOffset &&
+                    packTextureSize(PACK_FORMAT_RGBA8, entry.width, entry.height, entry.levels, expected) &&
+                    entry.dataSize == expected &&
+                    (i == 0 || table[i - 1].key < entry.key);
+        }
+        if (!valid) {
+            cerr << "Cache compartilhado de assets: " << name << " com índice inválido, ignorado" << endl;
+        }
+    }
+
+    if (!valid) {
+        // Incompleto e o criador morreu: remove para que alguém publique de novo
+        if (ready != 1 && !processAlive(candidate->creatorPid)) {
+            shm_unlink(name.c_str());
+        }
+        munmap(view, size);
+        return false;
+    }
+
+    header = candidate;
+    entries = reinterpret_cast<const SharedImageEntry*>(header + 1);
+    mappedSize = size;
+    return true;
+}
+
+bool SharedAssetCache::publish()
+{
+    if (!recording) return false;
+    recording = false;
+
+    lock_guard<mutex> guard(pendingLock);
+    if (pending.empty()) return false;
+
+    // Índice, depois os pixels de cada imagem alinhados
+    uint64_t dataOffset = alignUp(sizeof(SharedCacheHeader) + pending.size() * sizeof(SharedImageEntry));
+    uint64_t totalSize = dataOffset;
+    for (const auto& pair : pending) {
+        totalSize = alignUp(totalSize + pair.second.pixels.size());
+    }
+
+    // O_EXCL: se outro processo publicou primeiro, usa o dele
+    // Só o dono lê e grava: outros usuários não alimentam este processo
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        pending.clear();
+        if (errno == EEXIST && attach()) {
+            cout << "Cache compartilhado de assets: publicado por outro processo, usando " << name << endl;
+            return true;
+        }
+        cerr << "Cache compartilhado de assets: não foi possível criar " << name << endl;
+        return false;
+    }
+    if (ftruncate(fd, (off_t)totalSize) != 0) {
+        cerr << "Cache compartilhado de assets: sem espaço para " << totalSize / (1024 * 1024) << " MB" << endl;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        pending.clear();
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        pending.clear();
+        return false;
+    }
+
+    unsigned char* bytes = static_cast<unsigned char*>(view);
+    SharedCacheHeader* writable = static_cast<SharedCacheHeader*>(view);
+    memcpy(writable->magic, SHARED_CACHE_MAGIC, sizeof(SHARED_CACHE_MAGIC));
+    writable->version = SHARED_CACHE_VERSION;
+    writable->key = key;
+    writable->creatorPid = (uint64_t)getpid();
+    writable->entryCount = (uint32_t)pending.size();
+    writable->totalSize = totalSize;
+
+    SharedImageEntry* table = reinterpret_cast<SharedImageEntry*>(writable + 1);
+    uint64_t offset = dataOffset;
+    size_t index = 0;
+    for (const auto& pair : pending) {
+        const PendingImage& image = pair.second;
+        SharedImageEntry& entry = table[index++];
+        entry.key = pair.first;
+        entry.contentHash = image.contentHash;
+        entry.width = (uint32_t)image.width;
+        entry.height = (uint32_t)image.height;
+        entry.levels = (uint32_t)image.levels;
+        entry.dataOffset = offset;
+        entry.dataSize = image.pixels.size();
+        memcpy(bytes + offset, image.pixels.data(), image.pixels.size());
+        offset = alignUp(offset + image.pixels.size());
+    }
+
+    // Só agora os outros processos passam a aceitar o segmento
+    __atomic_store_n(&writable->ready, 1u, __ATOMIC_RELEASE);
+    munmap(view, (size_t)totalSize);
+
+    size_t count = pending.size();
+    pending.clear();
+    cout << "Cache compartilhado de assets publicado: " << name << " (" << count << " texturas, "
+         << totalSize / 1024 << " KB)" << endl;
+
+    // Daqui em diante este processo também lê do segmento
+    return attach();
+}
+
+void SharedAssetCache::close()
+{
+    if (header != nullptr) {
+        munmap(const_cast<SharedCacheHeader*>(header), mappedSize);
+    }
+    header = nullptr;
+    entries = nullptr;
+    mappedSize = 0;
+    recording = false;
+
+    lock_guard<mutex> guard(pendingLock);
+    pending.clear();
+}
+
+#endif
+
+const SharedImageEntry* SharedAssetCache::find(uint64_t imageKey) const
+{
+    if (header == nullptr || imageKey == 0) return nullptr;
+
+    const SharedImageEntry* end = entries + header->entryCount;
+    const SharedImageEntry* it = lower_bound(entries, end, imageKey,
+        [](const SharedImageEntry& entry, uint64_t value) { return entry.key < value; });
+    if (it == end || it->key != imageKey) return nullptr;
+    if (it->dataOffset > mappedSize || it->dataSize > mappedSize - it->dataOffset) return nullptr;
+    return it;
+}
+
+const unsigned char* SharedAssetCache::entryData(const SharedImageEntry& entry) const
+{
+    return reinterpret_cast<const unsigned char*>(header) + entry.dataOffset;
+}
+
+void SharedAssetCache::record(uint64_t imageKey, uint64_t contentHash, int width, int height, int levels,
+                              const unsigned char* pixels, size_t size)
+{
+    if (!recording || imageKey == 0) return;
+
+    lock_guard<mutex> guard(pendingLock);
+    PendingImage& image = pending[imageKey];
+    image.contentHash = contentHash;
+    image.width = width;
+    image.height = height;
+    image.levels = levels;
+    image.pixels.assign(pixels, pixels + size);
+}
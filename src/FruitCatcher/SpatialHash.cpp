@@ -0,0 +1,122 @@
+#include "SpatialHash.h"
+
+#include <cmath>
+#include <algorithm>
+
+SpatialHash::SpatialHash(float size)
+    : boxes(nullptr), bucketMask(0), stamp(0)
+{
+    setCellSize(size);
+}
+
+void SpatialHash::setCellSize(float size)
+{
+    cellSize = size > 0.0f ? size : 64.0f;
+    inverseCellSize = 1.0f / cellSize;
+}
+
+int32_t SpatialHash::cellCoord(float value) const
+{
+    return (int32_t)floor(value * inverseCellSize);
+}
+
+uint32_t SpatialHash::bucketOf(int32_t cellX, int32_t cellY) const
+{
+    // Primos grandes espalham células vizinhas por baldes diferentes
+    uint32_t hash = (uint32_t)cellX * 73856093u ^ (uint32_t)cellY * 19349663u;
+    return hash & bucketMask;
+}
+
+void SpatialHash::build(const vector<AABB>& source)
+{
+    boxes = &source;
+
+    scratch.clear();
+    for (uint32_t i = 0; i < (uint32_t)source.size(); i++) {
+        const AABB& box = source[i];
+        int32_t x0 = cellCoord(box.minX), x1 = cellCoord(box.maxX);
+        int32_t y0 = cellCoord(box.minY), y1 = cellCoord(box.maxY);
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                scratch.push_back({x, y, i});
+            }
+        }
+    }
+
+    // Cerca de 2 baldes por entrada (potência de 2, para usar máscara)
+    uint32_t bucketCount = 16;
+    while (bucketCount < scratch.size() * 2) bucketCount <<= 1;
+    bucketMask = bucketCount - 1;
+
+    // Ordenação por contagem: conta, acumula e distribui
+    bucketStart.assign(bucketCount + 1, 0);
+    for (const CellEntry& entry : scratch) {
+        bucketStart[bucketOf(entry.cellX, entry.cellY) + 1]++;
+    }
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    cells.resize(scratch.size());
+    cursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (const CellEntry& entry : scratch) {
+        cells[cursor[bucketOf(entry.cellX, entry.cellY)]++] = entry;
+    }
+
+    stamps.assign(source.size(), 0);
+    stamp = 0;
+}
+
+void SpatialHash::query(const AABB& box, vector<uint32_t>& out) const
+{
+    out.clear();
+    if (boxes == nullptr || cells.empty()) return;
+
+    if (++stamp == 0) {
+        fill(stamps.begin(), stamps.end(), 0);
+        stamp = 1;
+    }
+
+    int32_t x0 = cellCoord(box.minX), x1 = cellCoord(box.maxX);
+    int32_t y0 = cellCoord(box.minY), y1 = cellCoord(box.maxY);
+    for (int32_t y = y0; y <= y1; y++) {
+        for (int32_t x = x0; x <= x1; x++) {
+            uint32_t bucket = bucketOf(x, y);
+            for (uint32_t k = bucketStart[bucket]; k < bucketStart[bucket + 1]; k++) {
+                const CellEntry& entry = cells[k];
+                if (entry.cellX != x || entry.cellY != y) continue; // outra célula no mesmo balde
+                if (stamps[entry.index] == stamp) continue;
+                stamps[entry.index] = stamp;
+                out.push_back(entry.index);
+            }
+        }
+    }
+    sort(out.begin(), out.end());
+}
+
+void SpatialHash::findPairs(vector<pair<uint32_t, uint32_t>>& out) const
+{
+    out.clear();
+    if (boxes == nullptr) return;
+    const vector<AABB>& source = *boxes;
+
+    for (uint32_t bucket = 0; bucket + 1 < (uint32_t)bucketStart.size(); bucket++) {
+        uint32_t begin = bucketStart[bucket], end = bucketStart[bucket + 1];
+        for (uint32_t a = begin; a < end; a++) {
+            const CellEntry& first = cells[a];
+            for (uint32_t b = a + 1; b < end; b++) {
+                const CellEntry& second = cells[b];
+                if (first.cellX != second.cellX || first.cellY != second.cellY) continue;
+
+                // Um par que divide várias células só é emitido na célula do
+                // canto mínimo da interseção das caixas
+                const AABB& boxA = source[first.index];
+                const AABB& boxB = source[second.index];
+                if (cellCoord(max(boxA.minX, boxB.minX)) != first.cellX ||
+                    cellCoord(max(boxA.minY, boxB.minY)) != first.cellY) continue;
+
+                uint32_t i = first.index, j = second.index;
+                out.push_back(i < j ? make_pair(i, j) : make_pair(j, i));
+            }
+        }
+    }
+}
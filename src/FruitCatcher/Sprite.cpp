@@ -1,12 +1,16 @@
 #include "Sprite.h"
 
+#include "TextureResidency.h"
+
+#include <map>
+
 Sprite::Sprite()
 {
     isActive = true;
+    VAO = 0;
     FPS = 12.0;
-    lastTime = 0.0;
+    animationStart = 0.0;
     iAnimation = 0;
-    iFrame = 0;
 }
 
 Sprite::~Sprite()
@@ -23,10 +27,9 @@ void Sprite::initialize(GLuint shaderID, GLuint texID, vec3 pos, vec3 dimensions
     this->nAnimations = nAnimations;
     this->nFrames = nFrames;
     this->iAnimation = 0;
-    this->iFrame = 0;
     this->d.s = 1.0 / (float)nFrames;
     this->d.t = 1.0 / (float)nAnimations;
-    this->VAO = setupGeometry();
+    this->VAO = 0;
 }
 
 void Sprite::update()
@@ -38,26 +41,70 @@ void Sprite::update()
 
     glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
 
-    vec2 offsetTex = vec2(iFrame * d.s, iAnimation * d.t);
-    glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), offsetTex.s, offsetTex.t);
+    updateAnimation();
+}
 
-    // Atualização da animação
-    float now = glfwGetTime();
-    float dt = now - lastTime;
+void Sprite::updateAnimation()
+{
+    setAnimationUniforms(shaderID, iAnimation, nAnimations, nFrames, animationStart, FPS);
+}
 
-    if (dt >= 1.0 / FPS && nFrames > 1)
-    {
-        iFrame = (iFrame + 1) % nFrames;
-        lastTime = now;
-    }
+void Sprite::setAnimationUniforms(GLuint shaderID, int iAnimation, int nAnimations, int nFrames,
+                                  float animationStart, float fps)
+{
+    // As texturas têm a primeira linha na base: a animação 0 (linha de cima
+    // da imagem) fica no topo do espaço de textura
+    float rowHeight = 1.0f / (float)nAnimations;
+    vec2 offsetTex = vec2(0.0f, 1.0f - (iAnimation + 1) * rowHeight);
+    glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), offsetTex.s, offsetTex.t);
+
+    // O frame (coluna) sai do vertex shader: (uTime - início) * FPS, módulo nFrames
+    glUniform4f(glGetUniformLocation(shaderID, "animation"), animationStart, fps, (float)nFrames, 1.0f / (float)nFrames);
 }
 
 void Sprite::draw()
 {
     if (!isActive) return;
 
+    if (VAO == 0) VAO = geometryFor(nAnimations, nFrames);
     glBindVertexArray(VAO);
-    glBindTexture(GL_TEXTURE_2D, texID);
+    bindTexture(texID);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+}
+
+void Sprite::getSnapshot(SpriteSnapshot& out) const
+{
+    out.texID = texID;
+    out.pos = pos;
+    out.dimensions = dimensions;
+    out.angle = angle;
+    out.nAnimations = nAnimations;
+    out.nFrames = nFrames;
+    out.iAnimation = iAnimation;
+    out.animationStart = animationStart;
+    out.FPS = FPS;
+    out.isActive = isActive;
+}
+
+void Sprite::drawSnapshot(GLuint shaderID, const SpriteSnapshot& snapshot, int motionSlot)
+{
+    if (!snapshot.isActive) return;
+
+    glUniform1i(glGetUniformLocation(shaderID, "motionSlot"), motionSlot);
+    if (motionSlot < 0)
+    {
+        mat4 model = mat4(1);
+        model = translate(model, snapshot.pos);
+        model = rotate(model, radians(snapshot.angle), vec3(0.0, 0.0, 1.0));
+        model = scale(model, snapshot.dimensions);
+        glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
+    }
+    setAnimationUniforms(shaderID, snapshot.iAnimation, snapshot.nAnimations, snapshot.nFrames,
+                         snapshot.animationStart, snapshot.FPS);
+
+    glBindVertexArray(geometryFor(snapshot.nAnimations, snapshot.nFrames));
+    bindTexture(snapshot.texID);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
 }
@@ -138,8 +185,22 @@ void Sprite::setFPS(float fps)
     this->FPS = fps;
 }
 
-GLuint Sprite::setupGeometry()
+void Sprite::setAnimationStart(float time)
 {
+    this->animationStart = time;
+}
+
+GLuint Sprite::geometryFor(int nAnimations, int nFrames)
+{
+    // A geometria só depende da grade da spritesheet: sprites com a mesma
+    // grade usam o mesmo VAO (antes cada objeto criado criava o seu)
+    static map<pair<int, int>, GLuint> sharedVAOs;
+    pair<int, int> grid(nAnimations, nFrames);
+    auto found = sharedVAOs.find(grid);
+    if (found != sharedVAOs.end()) return found->second;
+
+    vec2 d = vec2(1.0f / (float)nFrames, 1.0f / (float)nAnimations);
+
     // Cada frame deve usar apenas uma porção da textura (d.s x d.t)
     // O offsetTex no shader irá deslocar para a linha/coluna correta
     GLfloat vertices[] = {
@@ -170,5 +231,6 @@ GLuint Sprite::setupGeometry()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
+    sharedVAOs[grid] = VAO;
     return VAO;
 }
@@ -0,0 +1,302 @@
+#include "StartupProfiler.h"
+#include "FileUtils.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// setw conta bytes: rótulos UTF-8 ("início", "máx") sairiam desalinhados.
+// Preenche pela largura em caracteres (bytes que não são de continuação)
+static string padColumn(const string& text, int width, bool alignLeft)
+{
+    int displayWidth = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) displayWidth++;
+    }
+    string padding(displayWidth < width ? width - displayWidth : 0, ' ');
+    return alignLeft ? text + padding : padding + text;
+}
+
+double threadCpuTimeMs()
+{
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exitTime, &kernel, &user)) return 0.0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (double)(k.QuadPart + u.QuadPart) / 10000.0; // unidades de 100 ns
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0.0;
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+#endif
+}
+
+// Diretório de um caminho (vazio se não houver)
+static string parentDirectory(const string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    return slash == string::npos ? string() : path.substr(0, slash);
+}
+
+static bool ensureParentDirectory(const string& path)
+{
+    string dir = parentDirectory(path);
+    if (dir.empty() || createDirectories(dir)) return true;
+    cerr << "Relatório de inicialização: não foi possível criar " << dir << endl;
+    return false;
+}
+
+StartupProfiler::StartupProfiler()
+    : startCpuMs(0.0), phaseStartMs(0.0), phaseStartCpuMs(0.0),
+      started(false), finished(false), totalMs(0.0), totalCpuMs(0.0)
+{
+}
+
+void StartupProfiler::start()
+{
+    startTime = chrono::steady_clock::now();
+    startCpuMs = threadCpuTimeMs();
+    phases.clear();
+    started = true;
+    finished = false;
+}
+
+double StartupProfiler::elapsedMs() const
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+}
+
+void StartupProfiler::endPhase()
+{
+    if (phases.empty()) return;
+    StartupPhase& phase = phases.back();
+    phase.wallMs = elapsedMs() - phaseStartMs;
+    phase.cpuMs = threadCpuTimeMs() - phaseStartCpuMs;
+}
+
+void StartupProfiler::beginPhase(const string& name)
+{
+    if (!started || finished) return;
+    endPhase();
+
+    StartupPhase phase;
+    phase.name = name;
+    phaseStartMs = elapsedMs();
+    phaseStartCpuMs = threadCpuTimeMs();
+    phase.startMs = phaseStartMs;
+    phases.push_back(phase);
+}
+
+void StartupProfiler::finish()
+{
+    if (!started || finished) return;
+    endPhase();
+    totalMs = elapsedMs();
+    totalCpuMs = threadCpuTimeMs() - startCpuMs;
+    finished = true;
+}
+
+string StartupProfiler::formatText() const
+{
+    ostringstream text;
+    text << fixed << setprecision(2);
+    text << "=== TEMPO DE INICIALIZAÇÃO ===" << endl;
+    text << padColumn("fase", 20, true) << padColumn("início", 10, false) << padColumn("relógio", 10, false)
+         << padColumn("CPU", 10, false) << padColumn("%", 8, false) << endl;
+    for (const StartupPhase& phase : phases) {
+        double share = totalMs > 0.0 ? phase.wallMs * 100.0 / totalMs : 0.0;
+        text << padColumn(phase.name, 20, true) << right << setw(10) << phase.startMs
+             << setw(10) << phase.wallMs << setw(10) << phase.cpuMs << setw(7) << share << "%" << endl;
+    }
+    text << "Total até o primeiro frame: " << totalMs << " ms (CPU da thread principal " << totalCpuMs << " ms)" << endl;
+
+    // A fase mais lenta é a primeira candidata a otimizar
+    const StartupPhase* slowest = nullptr;
+    for (const StartupPhase& phase : phases) {
+        if (slowest == nullptr || phase.wallMs > slowest->wallMs) slowest = &phase;
+    }
+    if (slowest != nullptr) {
+        text << "Fase mais lenta: " << slowest->name << " (" << slowest->wallMs << " ms";
+        if (slowest->wallMs > 0.0 && slowest->cpuMs < slowest->wallMs * 0.5) {
+            text << ", maior parte esperando E/S ou o driver";
+        }
+        text << ")" << endl;
+    }
+    text << "==============================" << endl;
+    return text.str();
+}
+
+bool StartupProfiler::writeReport(const string& basePath) const
+{
+    string summary = formatText();
+    cout << "\n" << summary << endl;
+
+    if (basePath.empty() || !ensureParentDirectory(basePath)) return false;
+
+    ostringstream json;
+    json << fixed << setprecision(3);
+    json << "{\n";
+    json << "  \"total_ms\": " << totalMs << ",\n";
+    json << "  \"total_cpu_ms\": " << totalCpuMs << ",\n";
+    json << "  \"phases\": [\n";
+    for (size_t i = 0; i < phases.size(); i++) {
+        const StartupPhase& phase = phases[i];
+        json << "    {\"name\": \"" << phase.name << "\", \"start_ms\": " << phase.startMs
+             << ", \"wall_ms\": " << phase.wallMs << ", \"cpu_ms\": " << phase.cpuMs << "}"
+             << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n";
+    json << "}\n";
+
+    string jsonText = json.str();
+    bool ok = writeFileAtomic(basePath + ".json", jsonText.data(), jsonText.size()) &&
+              writeFileAtomic(basePath + ".txt", summary.data(), summary.size());
+    if (!ok) {
+        cerr << "Relatório de inicialização: erro ao gravar " << basePath << ".json/.txt" << endl;
+        return false;
+    }
+    cout << "Relatório de inicialização: " << basePath << ".json" << endl;
+    return true;
+}
+
+bool StartupProfiler::appendRun(const string& runsPath) const
+{
+    if (!ensureParentDirectory(runsPath)) return false;
+
+    ofstream file(runsPath, ios::app);
+    if (!file.is_open()) return false;
+
+    // Uma linha por fase: nome<TAB>relógio<TAB>CPU; a linha "total" fecha a execução
+    file << fixed << setprecision(3);
+    for (const StartupPhase& phase : phases) {
+        file << phase.name << "\t" << phase.wallMs << "\t" << phase.cpuMs << "\n";
+    }
+    file << "total\t" << totalMs << "\t" << totalCpuMs << "\n";
+    return true;
+}
+
+// ===== --startup-bench =====
+
+struct PhaseSamples {
+    vector<double> wall;
+    vector<double> cpu;
+};
+
+static double percentile(vector<double> values, double p)
+{
+    if (values.empty()) return 0.0;
+    sort(values.begin(), values.end());
+    size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[min(index, values.size() - 1)];
+}
+
+static double mean(const vector<double>& values)
+{
+    if (values.empty()) return 0.0;
+    double sum = 0.0;
+    for (double value : values) sum += value;
+    return sum / values.size();
+}
+
+int runStartupBenchmark(const string& executable, int runs, const string& basePath)
+{
+    if (runs <= 0) {
+        cerr << "--startup-bench precisa de um número de execuções maior que zero" << endl;
+        return 1;
+    }
+
+    string runsPath = basePath + "_runs.tsv";
+    if (!ensureParentDirectory(runsPath)) return 1;
+    remove(runsPath.c_str());
+
+    cout << "=== BENCHMARK DE INICIALIZAÇÃO (" << runs << " execuções) ===" << endl;
+    for (int i = 0; i < runs; i++) {
+        string command = "\"" + executable + "\" --startup-run";
+#ifdef _WIN32
+        command = "\"" + command + "\""; // cmd.exe remove o primeiro par de aspas
+#endif
+        int status = system(command.c_str());
+        if (status != 0) {
+            cerr << "Execução " << (i + 1) << " falhou (status " << status << ")" << endl;
+            return 1;
+        }
+        cout << "Execução " << (i + 1) << "/" << runs << " concluída" << endl;
+    }
+
+    // Lê as amostras mantendo a ordem em que as fases aparecem
+    ifstream file(runsPath);
+    if (!file.is_open()) {
+        cerr << "Benchmark de inicialização: não foi possível ler " << runsPath << endl;
+        return 1;
+    }
+    vector<string> order;
+    map<string, PhaseSamples> samples;
+    string line;
+    while (getline(file, line)) {
+        istringstream fields(line);
+        string name;
+        double wall = 0.0, cpu = 0.0;
+        if (!getline(fields, name, '\t') || !(fields >> wall >> cpu)) continue;
+        if (samples.find(name) == samples.end()) order.push_back(name);
+        samples[name].wall.push_back(wall);
+        samples[name].cpu.push_back(cpu);
+    }
+
+    ostringstream text, json;
+    text << fixed << setprecision(2);
+    json << fixed << setprecision(3);
+    text << "=== DISTRIBUIÇÃO DA INICIALIZAÇÃO (" << runs << " execuções, ms) ===" << endl;
+    text << padColumn("fase", 20, true) << padColumn("mín", 10, false) << padColumn("mediana", 10, false)
+         << padColumn("p90", 10, false) << padColumn("máx", 10, false) << padColumn("CPU méd", 10, false) << endl;
+    json << "{\n  \"runs\": " << runs << ",\n  \"phases\": [\n";
+    for (size_t i = 0; i < order.size(); i++) {
+        const PhaseSamples& phase = samples[order[i]];
+        double minimum = percentile(phase.wall, 0.0);
+        double median = percentile(phase.wall, 0.5);
+        double p90 = percentile(phase.wall, 0.9);
+        double maximum = percentile(phase.wall, 1.0);
+        double cpuMean = mean(phase.cpu);
+
+        text << padColumn(order[i], 20, true) << right << setw(10) << minimum << setw(10) << median
+             << setw(10) << p90 << setw(10) << maximum << setw(10) << cpuMean << endl;
+        json << "    {\"name\": \"" << order[i] << "\", \"samples\": " << phase.wall.size()
+             << ", \"min_ms\": " << minimum << ", \"median_ms\": " << median << ", \"p90_ms\": " << p90
+             << ", \"max_ms\": " << maximum << ", \"mean_ms\": " << mean(phase.wall)
+             << ", \"cpu_mean_ms\": " << cpuMean << "}" << (i + 1 < order.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    text << "A primeira execução costuma ser a mais lenta (caches de shader/áudio frios)" << endl;
+    text << "==============================" << endl;
+
+    string summary = text.str();
+    string jsonText = json.str();
+    cout << "\n" << summary << endl;
+    if (!writeFileAtomic(basePath + "_bench.json", jsonText.data(), jsonText.size()) ||
+        !writeFileAtomic(basePath + "_bench.txt", summary.data(), summary.size())) {
+        cerr << "Benchmark de inicialização: erro ao gravar " << basePath << "_bench.json/.txt" << endl;
+        return 1;
+    }
+    cout << "Relatório do benchmark: " << basePath << "_bench.json" << endl;
+    return 0;
+}
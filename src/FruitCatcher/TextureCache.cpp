@@ -0,0 +1,465 @@
+#include "TextureCache.h"
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#include <stb_image.h>
+
+#include "FileUtils.h"
+#include "GLExtensions.h"
+#include "ImageOps.h"
+#include "BC7.h"
+
+// Parâmetros comuns a todas as texturas do jogo
+static void setDefaultParameters(int levels)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
+
+// Reserva todos os níveis de uma vez (textura imutável) quando o driver
+// suporta; senão, cria cada nível vazio com glTexImage2D
+static void allocateStorage(int levels, GLenum internalFormat, int width, int height)
+{
+    if (glExtensions.textureStorage) {
+        glExtensions.texStorage2D(GL_TEXTURE_2D, levels, internalFormat, width, height);
+        return;
+    }
+    for (int level = 0; level < levels; level++) {
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+}
+
+// Tamanho final respeitando o limite pedido (0 = sem limite), sem ampliar
+static void fitSize(int width, int height, int maxWidth, int maxHeight, int& outWidth, int& outHeight)
+{
+    outWidth = maxWidth > 0 && maxWidth < width ? maxWidth : width;
+    outHeight = maxHeight > 0 && maxHeight < height ? maxHeight : height;
+}
+
+// O mesmo arquivo em tamanhos diferentes são texturas diferentes
+static uint64_t sizedHash(uint64_t contentHash, int maxWidth, int maxHeight)
+{
+    if (maxWidth <= 0 && maxHeight <= 0) return contentHash;
+    uint64_t parts[3] = { contentHash, (uint64_t)maxWidth, (uint64_t)maxHeight };
+    return hashBytes(parts, sizeof(parts));
+}
+
+static bool prepareDecoded(const unsigned char* fileData, size_t fileSize, PreparedImage& image);
+
+TextureCache::TextureCache() : assetPack(nullptr), shared(nullptr), bptcWarned(false)
+{
+}
+
+TextureCache::~TextureCache()
+{
+    // As texturas da GPU morrem com o contexto; aqui só libera a memória.
+    // Cada textura aparece uma única vez no mapa por conteúdo
+    for (auto& pair : byContent) {
+        delete pair.second;
+    }
+}
+
+// Chave por caminho (o limite de tamanho faz parte dela)
+static string sizedKey(const string& filePath, int maxWidth, int maxHeight)
+{
+    string key = normalizeAssetPath(filePath);
+    if (maxWidth > 0 || maxHeight > 0) {
+        key += "@" + to_string(maxWidth) + "x" + to_string(maxHeight);
+    }
+    return key;
+}
+
+bool TextureCache::canUploadDirectly(const string& filePath, int maxWidth, int maxHeight) const
+{
+    const PackEntry* packed = assetPack != nullptr ? assetPack->find(filePath) : nullptr;
+    if (packed != nullptr && packed->type == PACK_TEXTURE) return true;
+    return shared != nullptr && shared->find(sharedImageKey(filePath, maxWidth, maxHeight)) != nullptr;
+}
+
+const CachedTexture* TextureCache::acquire(const string& filePath, int maxWidth, int maxHeight)
+{
+    string key = sizedKey(filePath, maxWidth, maxHeight);
+
+    // 1) Mesmo caminho já carregado
+    auto it = byPath.find(key);
+    if (it != byPath.end()) {
+        stats.pathHits++;
+        return share(it->second, key);
+    }
+
+    // 2) Pacote de assets: o hash do conteúdo já vem no índice
+    const PackEntry* packed = assetPack != nullptr ? assetPack->find(filePath) : nullptr;
+    if (packed != nullptr && packed->type == PACK_TEXTURE) {
+        uint64_t contentHash = sizedHash(packed->sourceHash, maxWidth, maxHeight);
+        auto same = byContent.find(contentHash);
+        if (same != byContent.end()) {
+            stats.contentHits++;
+            return share(same->second, key);
+        }
+
+        CachedTexture* texture = uploadPacked(*packed, maxWidth, maxHeight);
+        insert(texture, key, contentHash);
+        cout << "Textura carregada (pacote): " << filePath << endl;
+        return texture;
+    }
+
+    // 3) Já decodificada por outro processo: envia direto da memória compartilhada
+    const SharedImageEntry* sharedImage = shared != nullptr ? shared->find(sharedImageKey(filePath, maxWidth, maxHeight)) : nullptr;
+    if (sharedImage != nullptr) {
+        auto same = byContent.find(sharedImage->contentHash);
+        if (same != byContent.end()) {
+            stats.contentHits++;
+            return share(same->second, key);
+        }
+
+        CachedTexture* texture = uploadRGBA(shared->entryData(*sharedImage), sharedImage->width, sharedImage->height);
+        insert(texture, key, sharedImage->contentHash);
+        cout << "Textura carregada (compartilhada): " << filePath << " (" << texture->width << "x" << texture->height << ")" << endl;
+        return texture;
+    }
+
+    // 4) Arquivo original: lê uma vez, identifica pelo conteúdo e só então decodifica
+    vector<unsigned char> fileData;
+    if (!readFile(filePath, fileData)) {
+        cout << "Falha ao carregar textura: " << filePath << endl;
+        return nullptr;
+    }
+
+    uint64_t contentHash = sizedHash(hashBytes(fileData.data(), fileData.size()), maxWidth, maxHeight);
+    auto same = byContent.find(contentHash);
+    if (same != byContent.end()) {
+        stats.contentHits++;
+        return share(same->second, key);
+    }
+
+    PreparedImage image;
+    image.path = filePath;
+    image.maxWidth = maxWidth;
+    image.maxHeight = maxHeight;
+    image.contentHash = contentHash;
+    if (!prepareDecoded(fileData.data(), fileData.size(), image)) {
+        cout << "Falha ao carregar textura: " << filePath << endl;
+        return nullptr;
+    }
+    CachedTexture* texture = uploadRGBA(image.pixels.data(), image.width, image.height);
+    insert(texture, key, contentHash);
+    recordShared(image);
+    cout << "Textura carregada: " << filePath << " (" << texture->width << "x" << texture->height << ")" << endl;
+    return texture;
+}
+
+const CachedTexture* TextureCache::acquirePrepared(const PreparedImage& image)
+{
+    // Enquanto a imagem era decodificada, outro pedido pode ter carregado a mesma
+    string key = sizedKey(image.path, image.maxWidth, image.maxHeight);
+    auto it = byPath.find(key);
+    if (it != byPath.end()) {
+        stats.pathHits++;
+        return share(it->second, key);
+    }
+    auto same = byContent.find(image.contentHash);
+    if (same != byContent.end()) {
+        stats.contentHits++;
+        return share(same->second, key);
+    }
+
+    CachedTexture* texture = uploadRGBA(image.pixels.data(), image.width, image.height);
+    insert(texture, key, image.contentHash);
+    recordShared(image);
+    cout << "Textura carregada: " << image.path << " (" << texture->width << "x" << texture->height << ")" << endl;
+    return texture;
+}
+
+const CachedTexture* TextureCache::acquireSolidColor(float r, float g, float b, float a)
+{
+    // Alfa pré-multiplicado, como as demais texturas
+    unsigned char pixel[4] = { (unsigned char)(r * a * 255), (unsigned char)(g * a * 255), (unsigned char)(b * a * 255), (unsigned char)(a * 255) };
+
+    char key[32];
+    snprintf(key, sizeof(key), "color:%02X%02X%02X%02X", pixel[0], pixel[1], pixel[2], pixel[3]);
+
+    auto it = byPath.find(key);
+    if (it != byPath.end()) {
+        stats.pathHits++;
+        return share(it->second, key);
+    }
+
+    CachedTexture* texture = new CachedTexture();
+    glGenTextures(1, &texture->id);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    allocateStorage(1, GL_RGBA8, 1, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    setDefaultParameters(1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    texture->width = 1;
+    texture->height = 1;
+    texture->format = GL_RGBA8;
+    texture->bytes = 4;
+    insert(texture, key, hashBytes(pixel, sizeof(pixel)));
+    return texture;
+}
+
+CachedTexture* TextureCache::share(CachedTexture* texture, const string& key)
+{
+    texture->refCount++;
+    byPath[key] = texture; // o caminho novo também passa a apontar para ela
+    return texture;
+}
+
+void TextureCache::insert(CachedTexture* texture, const string& key, uint64_t contentHash)
+{
+    texture->key = key;
+    texture->contentHash = contentHash;
+    texture->refCount = 1;
+    byPath[key] = texture;
+    byContent[contentHash] = texture;
+
+    stats.loads++;
+    stats.textures++;
+    stats.bytesResident += texture->bytes;
+}
+
+// Bytes de um nível de mipmap do pacote
+static size_t packedLevelSize(uint32_t format, int width, int height)
+{
+    return format == PACK_FORMAT_BC7 ? bc7ImageSize(width, height) : (size_t)width * height * 4;
+}
+
+CachedTexture* TextureCache::uploadPacked(const PackEntry& packed, int maxWidth, int maxHeight)
+{
+    // Mipmaps já prontos, lidos direto do arquivo mapeado. Com limite de
+    // tamanho, pula os níveis maiores que o necessário
+    int targetWidth, targetHeight;
+    fitSize(packed.width, packed.height, maxWidth, maxHeight, targetWidth, targetHeight);
+
+    const unsigned char* pixels = assetPack->entryData(packed);
+    int width = packed.width;
+    int height = packed.height;
+    int firstLevel = 0;
+    while (firstLevel + 1 < (int)packed.mipLevels &&
+           width / 2 >= targetWidth && height / 2 >= targetHeight) {
+        pixels += packedLevelSize(packed.format, width, height);
+        width = max(1, width / 2);
+        height = max(1, height / 2);
+        firstLevel++;
+    }
+    int levels = (int)packed.mipLevels - firstLevel;
+
+    // BC7 vai comprimido para a GPU; sem suporte a BPTC, é descomprimido aqui
+    bool compressed = packed.format == PACK_FORMAT_BC7 && glExtensions.compressionBPTC;
+    if (packed.format == PACK_FORMAT_BC7 && !compressed && !bptcWarned) {
+        cout << "Aviso: GPU sem suporte a BC7, descomprimindo texturas do pacote para RGBA" << endl;
+        bptcWarned = true;
+    }
+
+    CachedTexture* texture = new CachedTexture();
+    texture->width = width;
+    texture->height = height;
+    texture->format = compressed ? GL_COMPRESSED_RGBA_BPTC_UNORM : GL_RGBA8;
+
+    glGenTextures(1, &texture->id);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    if (glExtensions.textureStorage) {
+        allocateStorage(levels, texture->format, width, height);
+    }
+
+    // Sem BPTC, a cadeia descomprimida pode já estar no cache compartilhado;
+    // senão é gravada lá depois de descomprimida aqui
+    uint64_t sharedKey = 0;
+    const unsigned char* sharedLevels = nullptr;
+    vector<unsigned char> recorded;
+    if (!compressed && packed.format == PACK_FORMAT_BC7 && shared != nullptr) {
+        sharedKey = sharedPackedKey(packed.sourceHash, firstLevel);
+        const SharedImageEntry* sharedImage = shared->find(sharedKey);
+        // A cadeia só serve se for exatamente a que seria enviada daqui
+        if (sharedImage != nullptr && (int)sharedImage->levels == levels &&
+            (int)sharedImage->width == width && (int)sharedImage->height == height) {
+            sharedLevels = shared->entryData(*sharedImage);
+        }
+    }
+
+    vector<unsigned char> decoded;
+    for (int level = 0; level < levels; level++) {
+        size_t levelBytes = packedLevelSize(packed.format, width, height);
+        if (compressed) {
+            if (glExtensions.textureStorage) {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, texture->format, (GLsizei)levelBytes, pixels);
+            } else {
+                glCompressedTexImage2D(GL_TEXTURE_2D, level, texture->format, width, height, 0, (GLsizei)levelBytes, pixels);
+            }
+            texture->bytes += levelBytes;
+        } else {
+            const unsigned char* rgba = pixels;
+            if (sharedLevels != nullptr) {
+                rgba = sharedLevels;
+                sharedLevels += (size_t)width * height * 4;
+            } else if (packed.format == PACK_FORMAT_BC7) {
+                decoded.resize((size_t)width * height * 4);
+                decodeBC7(pixels, width, height, decoded.data());
+                rgba = decoded.data();
+                if (shared != nullptr && shared->isRecording()) {
+                    recorded.insert(recorded.end(), decoded.begin(), decoded.end());
+                }
+            }
+            if (glExtensions.textureStorage) {
+                glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+            }
+            texture->bytes += (size_t)width * height * 4;
+        }
+        pixels += levelBytes;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    setDefaultParameters(levels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (!recorded.empty()) {
+        shared->record(sharedKey, packed.sourceHash, texture->width, texture->height, levels, recorded.data(), recorded.size());
+    }
+    return texture;
+}
+
+bool TextureCache::prepareImage(const string& filePath, int maxWidth, int maxHeight, PreparedImage& out)
+{
+    vector<unsigned char> fileData;
+    if (!readFile(filePath, fileData)) return false;
+
+    out.path = filePath;
+    out.maxWidth = maxWidth;
+    out.maxHeight = maxHeight;
+    out.contentHash = sizedHash(hashBytes(fileData.data(), fileData.size()), maxWidth, maxHeight);
+    return prepareDecoded(fileData.data(), fileData.size(), out);
+}
+
+// Decodifica o arquivo em memória e prepara os pixels (sem OpenGL)
+static bool prepareDecoded(const unsigned char* fileData, size_t fileSize, PreparedImage& image)
+{
+    int width, height, nrChannels;
+    if (!stbi_info_from_memory(fileData, (int)fileSize, &width, &height, &nrChannels)) return false;
+
+    // RGB e RGBA são convertidos aqui; tons de cinza o stb já entrega em RGBA
+    int requestedChannels = nrChannels == 3 || nrChannels == 4 ? 0 : 4;
+    unsigned char* data = stbi_load_from_memory(fileData, (int)fileSize, &width, &height, &nrChannels, requestedChannels);
+    if (data == nullptr) return false;
+    if (requestedChannels != 0) nrChannels = requestedChannels;
+
+    // RGBA8 pré-multiplicado, de baixo para cima
+    vector<unsigned char> rgba;
+    unsigned char* pixels = data;
+    if (nrChannels == 3) {
+        // Inverte as linhas durante a expansão (sem passada extra)
+        rgba.resize((size_t)width * height * 4);
+        for (int y = 0; y < height; y++) {
+            expandRGBToRGBA(data + (size_t)y * width * 3, rgba.data() + (size_t)(height - 1 - y) * width * 4, width);
+        }
+        pixels = rgba.data();
+    } else {
+        premultiplyAlpha(data, (size_t)width * height);
+        flipRowsRGBA(data, width, height);
+    }
+
+    // Redução para o tamanho na tela (depois da pré-multiplicação, para não
+    // escurecer as bordas transparentes)
+    int targetWidth, targetHeight;
+    fitSize(width, height, image.maxWidth, image.maxHeight, targetWidth, targetHeight);
+    image.width = targetWidth;
+    image.height = targetHeight;
+    if (targetWidth != width || targetHeight != height) {
+        image.pixels.resize((size_t)targetWidth * targetHeight * 4);
+        resizeRGBA(pixels, width, height, image.pixels.data(), targetWidth, targetHeight);
+    } else if (pixels == rgba.data()) {
+        image.pixels.swap(rgba);
+    } else {
+        image.pixels.assign(pixels, pixels + (size_t)width * height * 4);
+    }
+    stbi_image_free(data);
+    return true;
+}
+
+// Envia só o nível 0 e deixa a GPU gerar os mipmaps
+CachedTexture* TextureCache::uploadRGBA(const unsigned char* pixels, int width, int height)
+{
+    CachedTexture* texture = new CachedTexture();
+    int levels = mipLevelCount(width, height);
+    glGenTextures(1, &texture->id);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+    allocateStorage(levels, GL_RGBA8, width, height);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    setDefaultParameters(levels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Mipmaps somam ~1/3
+    texture->width = width;
+    texture->height = height;
+    texture->format = GL_RGBA8;
+    texture->bytes = (size_t)width * height * 4 * 4 / 3;
+    return texture;
+}
+
+void TextureCache::recordShared(const PreparedImage& image)
+{
+    if (shared == nullptr || !shared->isRecording()) return;
+    shared->record(sharedImageKey(image.path, image.maxWidth, image.maxHeight), image.contentHash,
+                   image.width, image.height, 1, image.pixels.data(), image.pixels.size());
+}
+
+void TextureCache::retain(const CachedTexture* texture)
+{
+    if (texture != nullptr) {
+        const_cast<CachedTexture*>(texture)->refCount++;
+    }
+}
+
+void TextureCache::release(const CachedTexture* texture)
+{
+    if (texture == nullptr) return;
+
+    CachedTexture* owned = const_cast<CachedTexture*>(texture);
+    if (--owned->refCount > 0) return;
+
+    destroy(owned);
+}
+
+const CachedTexture* TextureCache::findById(GLuint id) const
+{
+    for (const auto& pair : byContent) {
+        if (pair.second->id == id) return pair.second;
+    }
+    return nullptr;
+}
+
+void TextureCache::destroy(CachedTexture* texture)
+{
+    // Remove todos os caminhos que apontavam para ela
+    for (auto it = byPath.begin(); it != byPath.end();) {
+        if (it->second == texture) it = byPath.erase(it);
+        else ++it;
+    }
+    byContent.erase(texture->contentHash);
+
+    stats.textures--;
+    stats.bytesResident -= texture->bytes;
+
+    glDeleteTextures(1, &texture->id);
+    delete texture;
+}
+
+void TextureCache::clear()
+{
+    while (!byContent.empty()) {
+        destroy(byContent.begin()->second);
+    }
+    byPath.clear();
+}
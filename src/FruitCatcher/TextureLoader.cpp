@@ -0,0 +1,120 @@
+#include "TextureLoader.h"
+
+#include <iostream>
+
+TextureLoader::TextureLoader() : jobSystem(nullptr), maxConcurrent(0), active(0), inFlight(0), stopping(false)
+{
+}
+
+TextureLoader::~TextureLoader()
+{
+    stop();
+}
+
+void TextureLoader::start(JobSystem* jobSystem, int maxConcurrent)
+{
+    if (this->jobSystem != nullptr || jobSystem == nullptr || jobSystem->getWorkerCount() == 0 || maxConcurrent <= 0) return;
+
+    this->jobSystem = jobSystem;
+    this->maxConcurrent = maxConcurrent;
+    stopping = false;
+    cout << "Decodificação de texturas: até " << maxConcurrent << " job(s) simultâneo(s)" << endl;
+}
+
+void TextureLoader::stop()
+{
+    if (jobSystem == nullptr) return;
+
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+        jobs.clear();
+    }
+    jobSystem->wait(running);
+    jobSystem = nullptr;
+
+    lock_guard<mutex> guard(lock);
+    results.clear();
+    inFlight = 0;
+}
+
+void TextureLoader::submit(GLuint handle, const string& filePath, int maxWidth, int maxHeight)
+{
+    bool startJob;
+    {
+        lock_guard<mutex> guard(lock);
+        jobs.push_back({handle, filePath, maxWidth, maxHeight});
+        inFlight++;
+        startJob = active < maxConcurrent;
+        if (startJob) active++;
+    }
+    if (startJob) {
+        jobSystem->run([this]() { decodeOne(); }, &running);
+    }
+}
+
+bool TextureLoader::poll(TextureLoadResult& out)
+{
+    lock_guard<mutex> guard(lock);
+    if (results.empty()) return false;
+
+    out = move(results.front());
+    results.pop_front();
+    inFlight--;
+    return true;
+}
+
+bool TextureLoader::wait(TextureLoadResult& out)
+{
+    unique_lock<mutex> guard(lock);
+    resultReady.wait(guard, [this] { return !results.empty() || inFlight == 0 || stopping; });
+    if (results.empty()) return false;
+
+    out = move(results.front());
+    results.pop_front();
+    inFlight--;
+    return true;
+}
+
+int TextureLoader::getPending() const
+{
+    lock_guard<mutex> guard(lock);
+    return inFlight;
+}
+
+// Cada job decodifica uma imagem e, se ainda houver fila, envia o próximo:
+// no máximo 'maxConcurrent' workers ficam com leitura de disco, e nenhum job
+// segura um worker por mais que uma imagem
+void TextureLoader::decodeOne()
+{
+    Job job;
+    {
+        lock_guard<mutex> guard(lock);
+        if (stopping || jobs.empty()) {
+            active--;
+            return;
+        }
+        job = move(jobs.front());
+        jobs.pop_front();
+    }
+
+    TextureLoadResult result;
+    result.handle = job.handle;
+    result.ok = TextureCache::prepareImage(job.path, job.maxWidth, job.maxHeight, result.image);
+    if (!result.ok) {
+        result.image.path = job.path;
+    }
+
+    bool next;
+    {
+        lock_guard<mutex> guard(lock);
+        results.push_back(move(result));
+        next = !stopping && !jobs.empty();
+        if (!next) active--;
+    }
+    resultReady.notify_all();
+
+    if (next) {
+        jobSystem->run([this]() { decodeOne(); }, &running);
+    }
+}
@@ -0,0 +1,447 @@
+#include "TextureResidency.h"
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include <stb_image.h>
+
+#include "GLExtensions.h"
+
+// Instância usada por bindTexture()
+static TextureResidency* activeResidency = nullptr;
+
+void bindTexture(GLuint handle)
+{
+    if (activeResidency != nullptr) {
+        activeResidency->bind(handle);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, handle);
+    }
+}
+
+TextureResidency::TextureResidency()
+    : cache(nullptr), assetPack(nullptr), loaderThreads(0), decodingBytes(0), currentScene(0), frame(1),
+      streamMsPerFrame(4.0), defaultStubId(0), budgetWarned(false)
+{
+}
+
+void TextureResidency::initialize(TextureCache* textureCache, const AssetPack* pack)
+{
+    cache = textureCache;
+    assetPack = pack;
+    activeResidency = this;
+
+    // Provisória padrão (transparente) para texturas que ainda não foram vistas
+    const CachedTexture* stub = cache->acquireSolidColor(0.0f, 0.0f, 0.0f, 0.0f);
+    defaultStubId = stub != nullptr ? stub->id : 0;
+}
+
+void TextureResidency::setLoaderThreads(int count, JobSystem* jobSystem)
+{
+    loader.stop();
+    loaderThreads = max(0, count);
+    loader.start(jobSystem, loaderThreads);
+}
+
+// Limite que atende às duas declarações (0 = original vence qualquer limite)
+static int mergeLimit(int current, int requested)
+{
+    if (current == 0 || requested == 0) return 0;
+    return max(current, requested);
+}
+
+// Memória de vídeo esperada para a textura já reduzida (com mipmaps)
+static size_t estimateBytes(int width, int height, int maxWidth, int maxHeight, bool compressed)
+{
+    if (maxWidth > 0) width = min(width, maxWidth);
+    if (maxHeight > 0) height = min(height, maxHeight);
+    size_t bytesPerTexel = compressed ? 1 : 4;
+    return (size_t)width * height * bytesPerTexel * 4 / 3;
+}
+
+GLuint TextureResidency::declare(const string& filePath, unsigned int scenes, int maxWidth, int maxHeight)
+{
+    string key = normalizeAssetPath(filePath);
+    auto it = handlesByPath.find(key);
+    if (it != handlesByPath.end()) {
+        GLuint handle = it->second;
+        Entry& entry = entries[handle - 1];
+        addScenes(handle, scenes);
+
+        int mergedWidth = mergeLimit(entry.maxWidth, maxWidth);
+        int mergedHeight = mergeLimit(entry.maxHeight, maxHeight);
+        if (mergedWidth != entry.maxWidth || mergedHeight != entry.maxHeight) {
+            entry.maxWidth = mergedWidth;
+            entry.maxHeight = mergedHeight;
+            entry.estimatedBytes = estimateBytes(entry.width, entry.height, mergedWidth, mergedHeight, entry.compressed);
+
+            // Já carregada menor do que agora é preciso: recarrega
+            if (entry.texture != nullptr) {
+                cache->release(entry.texture);
+                entry.texture = nullptr;
+                queue(handle, false);
+            }
+        }
+        return handle;
+    }
+
+    // Descobre as dimensões sem decodificar: índice do pacote ou cabeçalho do arquivo
+    Entry entry;
+    const PackEntry* packed = assetPack != nullptr ? assetPack->find(filePath) : nullptr;
+    if (packed != nullptr && packed->type == PACK_TEXTURE) {
+        entry.width = packed->width;
+        entry.height = packed->height;
+        entry.compressed = packed->format == PACK_FORMAT_BC7 && glExtensions.compressionBPTC;
+    } else {
+        int channels;
+        if (!stbi_info(filePath.c_str(), &entry.width, &entry.height, &channels)) {
+            cout << "Falha ao carregar textura: " << filePath << endl;
+            return 0;
+        }
+    }
+
+    entry.maxWidth = maxWidth;
+    entry.maxHeight = maxHeight;
+    entry.estimatedBytes = estimateBytes(entry.width, entry.height, maxWidth, maxHeight, entry.compressed);
+    entry.path = filePath;
+    entry.scenes = scenes;
+    entries.push_back(entry);
+
+    GLuint handle = (GLuint)entries.size();
+    handlesByPath[key] = handle;
+
+    // Textura da cena atual: já entra na fila
+    if (scenes & currentScene) {
+        queue(handle, false);
+    }
+    return handle;
+}
+
+GLuint TextureResidency::declareSolidColor(float r, float g, float b, float a)
+{
+    const CachedTexture* texture = cache->acquireSolidColor(r, g, b, a);
+    if (texture == nullptr) return 0;
+
+    auto it = handlesByPath.find(texture->key);
+    if (it != handlesByPath.end()) {
+        cache->release(texture); // já temos uma referência para esta cor
+        return it->second;
+    }
+
+    Entry entry;
+    entry.path = texture->key;
+    entry.scenes = SCENE_ALL;
+    entry.texture = texture;
+    entry.width = 1;
+    entry.height = 1;
+    entry.estimatedBytes = texture->bytes;
+    entry.pinned = true;
+    entries.push_back(entry);
+
+    GLuint handle = (GLuint)entries.size();
+    handlesByPath[texture->key] = handle;
+    return handle;
+}
+
+void TextureResidency::addScenes(GLuint handle, unsigned int scenes)
+{
+    if (handle == 0 || handle > entries.size()) return;
+    entries[handle - 1].scenes |= scenes;
+}
+
+bool TextureResidency::getSize(GLuint handle, int& width, int& height) const
+{
+    if (handle == 0 || handle > entries.size()) return false;
+    width = entries[handle - 1].width;
+    height = entries[handle - 1].height;
+    return true;
+}
+
+void TextureResidency::queue(GLuint handle, bool urgent)
+{
+    Entry& entry = entries[handle - 1];
+    if (entry.queued || entry.decoding || entry.failed || entry.texture != nullptr) return;
+
+    entry.queued = true;
+    if (urgent) {
+        loadQueue.push_front(handle); // pedida num bind: antes das pré-carregadas
+    } else {
+        loadQueue.push_back(handle);
+    }
+}
+
+void TextureResidency::beginFrame(unsigned int scene)
+{
+    frame++;
+
+    // Cena nova: tudo que ela usa entra na fila
+    if (scene != currentScene) {
+        currentScene = scene;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].scenes & scene) {
+                queue((GLuint)(i + 1), false);
+            }
+        }
+    }
+
+    // Envia o que as threads já decodificaram e carrega da fila até esgotar o
+    // tempo do frame (pelo menos uma por frame)
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool timeLeft = true;
+    TextureLoadResult result;
+    while (timeLeft && loader.poll(result)) {
+        finishDecode(result);
+        timeLeft = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() < streamMsPerFrame;
+    }
+    while (!loadQueue.empty() && timeLeft) {
+        GLuint handle = loadQueue.front();
+        loadQueue.pop_front();
+        entries[handle - 1].queued = false;
+
+        // Decodificação nas threads não gasta o tempo do frame
+        if (startDecode(handle)) continue;
+
+        load(handle);
+        timeLeft = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() < streamMsPerFrame;
+    }
+
+    // Sobrou tempo: adianta uma textura de outra cena, se couber sem remover nada
+    if (loadQueue.empty() && timeLeft) {
+        prefetchIdle();
+    }
+
+    // Orçamento diminuído ou texturas compartilhadas podem deixá-lo estourado
+    makeRoom(0, false);
+}
+
+void TextureResidency::loadSceneNow(unsigned int scene)
+{
+    currentScene = scene;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].scenes & scene) {
+            queue((GLuint)(i + 1), false);
+        }
+    }
+
+    // Todas as decodificações saem de uma vez para as threads; as que vêm do
+    // pacote são enviadas aqui enquanto isso
+    TextureLoadResult result;
+    do {
+        while (!loadQueue.empty()) {
+            GLuint handle = loadQueue.front();
+            loadQueue.pop_front();
+            entries[handle - 1].queued = false;
+            if (!startDecode(handle)) load(handle);
+        }
+        while (loader.wait(result)) {
+            finishDecode(result);
+        }
+    } while (!loadQueue.empty());
+}
+
+bool TextureResidency::isSceneReady(unsigned int scene) const
+{
+    size_t bytesResident = cache != nullptr ? cache->getStats().bytesResident : 0;
+    for (const Entry& entry : entries) {
+        if (!(entry.scenes & scene) || entry.texture != nullptr || entry.failed || entry.pinned) continue;
+        if (!entry.decoding && stats.budgetBytes > 0 && bytesResident + entry.estimatedBytes > stats.budgetBytes) continue;
+        return false;
+    }
+    return true;
+}
+
+void TextureResidency::reserve(const Entry& entry)
+{
+    if (!makeRoom(entry.estimatedBytes, true) && !budgetWarned) {
+        cerr << "Aviso: orçamento de texturas (" << stats.budgetBytes / (1024 * 1024)
+             << " MB) menor que o necessário para a cena atual" << endl;
+        budgetWarned = true;
+    }
+}
+
+bool TextureResidency::load(GLuint handle)
+{
+    Entry& entry = entries[handle - 1];
+    if (entry.texture != nullptr) return true;
+
+    reserve(entry);
+    entry.texture = cache->acquire(entry.path, entry.maxWidth, entry.maxHeight);
+    if (entry.texture == nullptr) {
+        entry.failed = true;
+        return false;
+    }
+
+    entry.estimatedBytes = entry.texture->bytes;
+    stats.loads++;
+    return true;
+}
+
+bool TextureResidency::startDecode(GLuint handle)
+{
+    Entry& entry = entries[handle - 1];
+    if (!loader.isRunning() || entry.pinned || cache->canUploadDirectly(entry.path, entry.maxWidth, entry.maxHeight)) return false;
+
+    entry.decoding = true;
+    decodingBytes += entry.estimatedBytes;
+    loader.submit(handle, entry.path, entry.maxWidth, entry.maxHeight);
+    return true;
+}
+
+void TextureResidency::finishDecode(TextureLoadResult& result)
+{
+    Entry& entry = entries[result.handle - 1];
+    entry.decoding = false;
+    decodingBytes -= min(decodingBytes, entry.estimatedBytes);
+
+    if (!result.ok) {
+        cout << "Falha ao carregar textura: " << entry.path << endl;
+        entry.failed = true;
+        return;
+    }
+
+    // O limite de tamanho mudou durante a decodificação: decodifica de novo
+    if (result.image.maxWidth != entry.maxWidth || result.image.maxHeight != entry.maxHeight) {
+        queue(result.handle, false);
+        return;
+    }
+    if (entry.texture != nullptr) return;
+
+    reserve(entry);
+    entry.texture = cache->acquirePrepared(result.image);
+    entry.estimatedBytes = entry.texture->bytes;
+    stats.loads++;
+}
+
+void TextureResidency::prefetchIdle()
+{
+    for (size_t i = 0; i < entries.size(); i++) {
+        Entry& entry = entries[i];
+        if (entry.texture != nullptr || entry.pinned || entry.queued || entry.decoding || entry.failed) continue;
+
+        size_t bytesResident = cache->getStats().bytesResident + decodingBytes;
+        if (stats.budgetBytes > 0 && bytesResident + entry.estimatedBytes > stats.budgetBytes) continue;
+
+        // Com threads, mantém cada uma ocupada; sem elas, uma por frame
+        if (startDecode((GLuint)(i + 1))) {
+            if (loader.getPending() >= loaderThreads) return;
+            continue;
+        }
+        load((GLuint)(i + 1));
+        return;
+    }
+}
+
+GLuint TextureResidency::pickVictim(bool allowCurrentScene) const
+{
+    // Menos usada recentemente, primeiro fora da cena atual; nunca uma usada
+    // no frame atual ou no anterior
+    GLuint victim = 0;
+    for (int pass = 0; pass < (allowCurrentScene ? 2 : 1) && victim == 0; pass++) {
+        unsigned long long oldest = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            const Entry& entry = entries[i];
+            if (entry.texture == nullptr || entry.pinned) continue;
+            if (entry.lastUsedFrame + 1 >= frame) continue;
+            if (pass == 0 && (entry.scenes & currentScene)) continue;
+
+            if (victim == 0 || entry.lastUsedFrame < oldest) {
+                victim = (GLuint)(i + 1);
+                oldest = entry.lastUsedFrame;
+            }
+        }
+    }
+    return victim;
+}
+
+bool TextureResidency::makeRoom(size_t bytes, bool allowCurrentScene)
+{
+    if (stats.budgetBytes == 0) return true;
+
+    while (cache->getStats().bytesResident + bytes > stats.budgetBytes) {
+        GLuint victim = pickVictim(allowCurrentScene);
+        if (victim == 0) return false;
+        evict(victim);
+    }
+    return true;
+}
+
+void TextureResidency::evict(GLuint handle)
+{
+    Entry& entry = entries[handle - 1];
+
+    // Guarda a cor média (último nível de mipmap) para servir de provisória
+    if (entry.stubId == 0) {
+        int level = (int)floor(log2((double)max(entry.texture->width, entry.texture->height)));
+        unsigned char pixel[4] = {0, 0, 0, 0};
+        glBindTexture(GL_TEXTURE_2D, entry.texture->id);
+        glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        // A textura está pré-multiplicada; acquireSolidColor espera alfa normal
+        float alpha = pixel[3] / 255.0f;
+        float unpremultiply = pixel[3] > 0 ? 1.0f / pixel[3] : 0.0f;
+        const CachedTexture* stub = cache->acquireSolidColor(min(1.0f, pixel[0] * unpremultiply), min(1.0f, pixel[1] * unpremultiply),
+                                                             min(1.0f, pixel[2] * unpremultiply), alpha);
+        entry.stubId = stub != nullptr ? stub->id : 0;
+    }
+
+    cache->release(entry.texture);
+    entry.texture = nullptr;
+    stats.evictions++;
+}
+
+void TextureResidency::bind(GLuint handle)
+{
+    if (handle == 0 || handle > entries.size()) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return;
+    }
+
+    Entry& entry = entries[handle - 1];
+    entry.lastUsedFrame = frame;
+
+    if (entry.texture != nullptr) {
+        glBindTexture(GL_TEXTURE_2D, entry.texture->id);
+        return;
+    }
+
+    // Ainda não está na GPU: pede com prioridade e desenha a provisória
+    queue(handle, true);
+    stats.stubBinds++;
+    glBindTexture(GL_TEXTURE_2D, entry.stubId != 0 ? entry.stubId : defaultStubId);
+}
+
+TextureResidencyStats TextureResidency::getStats() const
+{
+    TextureResidencyStats current = stats;
+    current.declared = (int)entries.size();
+    current.resident = 0;
+    for (const Entry& entry : entries) {
+        if (entry.texture != nullptr) current.resident++;
+        if (entry.decoding) current.decoding++;
+    }
+    current.bytesResident = cache != nullptr ? cache->getStats().bytesResident : 0;
+    return current;
+}
+
+void TextureResidency::clear()
+{
+    // Descarta as decodificações em andamento antes de apagar as entradas
+    loader.stop();
+    decodingBytes = 0;
+
+    for (Entry& entry : entries) {
+        if (entry.texture != nullptr) {
+            cache->release(entry.texture);
+        }
+    }
+    entries.clear();
+    handlesByPath.clear();
+    loadQueue.clear();
+
+    if (activeResidency == this) {
+        activeResidency = nullptr;
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "FileUtils.h"
+
+using namespace std;
+
+// Tipos de entrada do pacote
+enum PackEntryType {
+    PACK_TEXTURE = 1,       // cadeia de mipmaps em sequência (nível 0 primeiro), no formato de 'format',
+                            // com alfa pré-multiplicado e linhas de baixo para cima
+    PACK_AUDIO_PCM = 2,     // amostras f32 intercaladas, prontas para tocar
+    PACK_AUDIO_ENCODED = 3  // arquivo original (mp3/wav), decodificado em streaming
+};
+
+// Formato dos texels de uma PACK_TEXTURE
+enum PackTextureFormat {
+    PACK_FORMAT_RGBA8 = 0,  // 4 bytes por texel
+    PACK_FORMAT_BC7 = 1     // blocos 4x4 de 16 bytes (BC7 modo 6)
+};
+
+// Cabeçalho do arquivo .pack
+struct PackHeader {
+    char magic[8];              // "FCPACK\0\0"
+    uint32_t version;
+    uint32_t entryCount;        // entradas logo após o cabeçalho
+    uint64_t stringTableOffset; // caminhos normalizados, terminados em '\0'
+    uint64_t stringTableSize;
+    uint64_t contentHash;       // hash de todo o conteúdo (identifica o pacote)
+};
+
+// Entrada do índice (tabela de conteúdo)
+struct PackEntry {
+    uint32_t type;          // PackEntryType
+    uint32_t nameOffset;    // posição do caminho na tabela de strings
+    uint64_t dataOffset;    // a partir do início do arquivo (alinhado a 64 bytes)
+    uint64_t dataSize;
+    uint64_t sourceHash;    // hash do arquivo original
+    uint32_t width;         // textura: dimensões do nível 0
+    uint32_t height;
+    uint32_t mipLevels;
+    uint32_t channels;      // áudio PCM
+    uint32_t sampleRate;
+    uint32_t format;        // textura: PackTextureFormat
+    uint64_t frameCount;
+};
+
+// Caminho usado como chave no pacote: barras normais e sem os "../" e "./"
+// do início, de modo que "../assets/x.png" (relativo ao build) e
+// "../../assets/x.png" (relativo ao config.txt) viram "assets/x.png"
+string normalizeAssetPath(const string& path);
+
+// Bytes da cadeia de mipmaps de uma textura (nível 0 primeiro, cada nível com
+// metade do anterior). false se o formato, as dimensões ou o número de níveis
+// são inválidos
+bool packTextureSize(uint32_t format, uint32_t width, uint32_t height, uint32_t levels, uint64_t& outBytes);
+
+// Pacote de assets pré-processados, mapeado em memória. Os dados das
+// entradas são usados direto do mapeamento, sem cópia nem decodificação.
+class AssetPack {
+public:
+    AssetPack();
+
+    bool open(const string& filePath);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    const PackEntry* find(const string& assetPath) const;
+    const unsigned char* entryData(const PackEntry& entry) const { return file.data() + entry.dataOffset; }
+    string entryName(const PackEntry& entry) const;
+
+    uint32_t getEntryCount() const { return (uint32_t)entryCount; }
+    uint64_t getContentHash() const { return contentHash; }
+    size_t getSize() const { return file.size(); }
+
+private:
+    MappedFile file;
+    const PackEntry* entries;
+    size_t entryCount;
+    const char* strings;
+    uint64_t contentHash;
+    unordered_map<string, size_t> index; // caminho normalizado -> entrada
+};
+
+// Monta um pacote novo (usado pela ferramenta fruitcatcher_cook)
+class AssetPackWriter {
+public:
+    // Os campos de posição de 'entry' são preenchidos na escrita
+    void add(const string& assetPath, const PackEntry& entry, const void* data, size_t size);
+    bool write(const string& filePath);
+    size_t getEntryCount() const { return entries.size(); }
+
+private:
+    vector<PackEntry> entries;
+    vector<string> names;
+    vector<vector<unsigned char>> blobs;
+};
+
+#endif // ASSETPACK_H
@@ -0,0 +1,55 @@
+#ifndef AUDIOCACHE_H
+#define AUDIOCACHE_H
+
+#include <miniaudio.h>
+#include <string>
+#include <cstdint>
+
+#include "FileUtils.h"
+
+using namespace std;
+
+// Cabeçalho dos arquivos .pcm do cache (amostras f32 intercaladas logo após)
+struct PCMCacheHeader {
+    char magic[8];        // "FCPCM\0\0\0"
+    uint32_t version;
+    uint32_t channels;
+    uint32_t sampleRate;
+    uint32_t dataOffset;  // início das amostras (alinhado)
+    uint64_t frameCount;
+    uint64_t sourceHash;  // hash do arquivo de origem (mp3/wav)
+};
+
+// Efeito sonoro já decodificado e mapeado em memória
+struct CachedPCM {
+    MappedFile file;
+    const float* frames = nullptr;
+    ma_uint64 frameCount = 0;
+    ma_uint32 channels = 0;
+    ma_uint32 sampleRate = 0;
+};
+
+// Cache em disco de efeitos sonoros decodificados.
+// Na primeira execução decodifica o arquivo para PCM f32 na taxa do motor
+// e grava em <diretório>/<hash>_<taxa>hz_<canais>ch.pcm; nas próximas
+// apenas mapeia o arquivo, sem nenhum custo de decodificação.
+class AudioCache {
+public:
+    AudioCache();
+
+    void setDirectory(const string& dir);
+    const string& getDirectory() const { return directory; }
+    void setAllocationCallbacks(const ma_allocation_callbacks& callbacks);
+
+    bool load(const string& sourcePath, ma_uint32 channels, ma_uint32 sampleRate, CachedPCM& out);
+
+private:
+    string directory;
+    ma_allocation_callbacks allocationCallbacks;
+
+    string cachePathFor(uint64_t sourceHash, ma_uint32 channels, ma_uint32 sampleRate) const;
+    bool mapCacheFile(const string& cachePath, uint64_t sourceHash, ma_uint32 channels, ma_uint32 sampleRate, CachedPCM& out);
+    bool decodeToCache(const string& sourcePath, const string& cachePath, uint64_t sourceHash, ma_uint32 channels, ma_uint32 sampleRate);
+};
+
+#endif // AUDIOCACHE_H
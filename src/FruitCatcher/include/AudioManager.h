@@ -5,15 +5,79 @@
 #include <string>
 #include <iostream>
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <future>
+#include <vector>
+
+#include "AudioCache.h"
+#include "AudioMemory.h"
+#include "MusicStream.h"
+#include "AssetPack.h"
 
 using namespace std;
 
+// Limites de vozes simultâneas (mantém o custo de mixagem limitado)
+struct AudioBudget {
+    int maxVoicesPerSound = 3;     // cópias do mesmo efeito tocando ao mesmo tempo
+    int maxTotalVoices = 6;        // total de efeitos tocando ao mesmo tempo
+    float coalesceWindowMs = 40.0f; // disparos do mesmo som dentro da janela viram um só
+};
+
+// Métricas do mixer, atualizadas a cada endFrame()
+struct AudioStats {
+    int activeVoices = 0;
+    int peakVoices = 0;
+    unsigned long long coalescedTriggers = 0; // disparos fundidos numa voz já tocando
+    unsigned long long stolenVoices = 0;      // vozes interrompidas para dar lugar a outra
+    unsigned long long culledTriggers = 0;    // disparos descartados por prioridade
+    double mixTimeMs = 0.0;     // tempo de CPU do mixer durante o último frame do jogo
+    double peakMixTimeMs = 0.0;
+    double mixLoad = 0.0;       // fração do tempo real gasta mixando (0.0 a 1.0)
+};
+
+// Efeito a carregar em segundo plano por initializeAsync()
+struct SoundRequest {
+    string name;
+    string filePath;
+    int priority;
+};
+
+// Uma voz: instância tocável de um efeito sonoro
+struct Voice {
+    ma_sound sound;
+    ma_audio_buffer_ref buffer; // fonte de dados apontando para o PCM do cache
+    bool initialized = false;
+    float volume = 0.0f;
+    double startTime = 0.0;     // segundos (relógio do AudioManager)
+};
+
+// Efeito sonoro carregado: pool de vozes lendo direto do PCM mapeado do cache
+struct SoundEntry {
+    Voice* voices = nullptr;
+    int voiceCount = 0;
+    int priority = 0;           // maior prioridade nunca é cortada por uma menor
+    int lastVoice = -1;         // voz do disparo mais recente (para coalescer)
+    CachedPCM cached;
+    bool fromCache = false;     // false = fallback decodificando o arquivo original
+    size_t mappedBytes = 0;     // PCM mapeado (cache ou pacote) contado no orçamento
+};
+
 class AudioManager {
 public:
     AudioManager();
     ~AudioManager();
 
     bool initialize();
+
+    // Sobe o áudio numa thread separada: inicializa o motor, carrega e toca a
+    // música e carrega os efeitos. Cada efeito fica disponível para playSound
+    // assim que termina de carregar; o future indica quando tudo acabou.
+    shared_future<bool> initializeAsync(const string& musicPath, float musicVolume,
+                                        const vector<SoundRequest>& effects);
+    bool isReady() const { return initialized && !loading; }
+
     bool loadMusic(const string& filePath);
     void playMusic(bool loop = true);
     void stopMusic();
@@ -22,18 +86,68 @@ public:
     void setMusicVolume(float volume); // 0.0 a 1.0
     bool isMusicPlaying();
 
+    // Tamanho/número de páginas e prioridade da decodificação da música (antes de loadMusic)
+    void setStreamConfig(const MusicStreamConfig& config) { streamConfig = config; }
+    bool isMusicStreamed() const { return musicStreamed; }
+    MusicStreamStats getMusicStats() const { return musicStream.getStats(); }
+
+    // Diretório do cache de PCM decodificado (antes de loadSound)
+    void setCacheDirectory(const string& dir);
+
+    // Pacote de assets com PCM pronto e a música (antes de loadSound/loadMusic).
+    // Tem precedência sobre o cache; o pacote precisa viver mais que o AudioManager
+    void setAssetPack(const AssetPack* pack) { assetPack = pack; }
+
+    // Limites de vozes (antes de loadSound)
+    void setBudget(const AudioBudget& budget);
+
+    // Limite de memória do áudio em bytes, 0 = sem limite (antes de initialize)
+    void setMemoryBudget(size_t bytes);
+    AudioMemoryStats getMemoryStats() { return memory.getStats(); }
+
     // Efeitos sonoros
-    bool loadSound(const string& name, const string& filePath);
+    bool loadSound(const string& name, const string& filePath, int priority = 0);
     void playSound(const string& name, float volume = 1.0f);
 
+    // Métricas: chamar uma vez por frame do jogo. getStats() devolve uma cópia
+    // consistente (playSound atualiza os contadores na thread da simulação)
+    void endFrame();
+    AudioStats getStats();
+
     void cleanup();
 
 private:
+    AudioMemory memory; // declarado antes do motor: precisa viver mais que ele
     ma_engine engine;
     ma_sound music;
-    map<string, ma_sound*> sounds; // Mapa de efeitos sonoros
-    bool initialized;
-    bool musicLoaded;
+    MusicStream musicStream;         // decodificação própria da música (fallback: stream do miniaudio)
+    MusicStreamConfig streamConfig;
+    atomic<bool> musicStreamed;
+    unsigned long long reportedUnderruns;
+    double lastUnderrunLog;
+    map<string, SoundEntry*> sounds; // Mapa de efeitos sonoros
+    mutex soundsLock;                // protege o mapa (a thread de carga insere nele)
+    AudioCache cache;
+    const AssetPack* assetPack;
+    AudioBudget budget;
+    AudioStats stats;                // protegido por soundsLock
+    atomic<bool> initialized;
+    atomic<bool> musicLoaded;
+    atomic<bool> loading;            // initializeAsync ainda em andamento
+    shared_future<bool> loadFuture;
+
+    // Tempo de mixagem acumulado pela thread de áudio
+    atomic<unsigned long long> mixNanos;
+    unsigned long long lastMixNanos;
+    chrono::steady_clock::time_point clockStart;
+    chrono::steady_clock::time_point lastFrameTime;
+
+    static void dataCallback(ma_device* device, void* output, const void* input, ma_uint32 frameCount);
+    double now() const;
+    bool initVoice(SoundEntry* entry, int index, const string& filePath);
+    int countActiveVoices(); // chamar com soundsLock travado
+    void startVoice(SoundEntry* entry, int index, float volume);
+    void releaseSound(SoundEntry* entry);
 };
 
 #endif // AUDIOMANAGER_H
@@ -0,0 +1,82 @@
+#ifndef AUDIOMEMORY_H
+#define AUDIOMEMORY_H
+
+#include <miniaudio.h>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Para onde vai cada byte alocado pelo áudio
+enum AudioMemCategory {
+    AUDIO_MEM_ENGINE,  // motor, nós do grafo de mixagem, resource manager
+    AUDIO_MEM_STREAM,  // buffers de streaming da música
+    AUDIO_MEM_SFX,     // efeitos sonoros decodificados e suas vozes
+    AUDIO_MEM_COUNT
+};
+
+struct AudioMemoryStats {
+    size_t bytesInUse[AUDIO_MEM_COUNT] = {0, 0, 0};
+    size_t mappedBytes = 0;       // PCM do cache mapeado (contado em AUDIO_MEM_SFX)
+    size_t poolReservedBytes = 0; // blocos reservados pelo pool de alocações pequenas
+    size_t totalBytes = 0;
+    size_t peakBytes = 0;
+    size_t budgetBytes = 0;       // 0 = sem limite
+    unsigned long long failedAllocations = 0;
+};
+
+// Alocador rastreado instalado no miniaudio via ma_allocation_callbacks.
+// Alocações pequenas saem de um pool por classes de tamanho (listas livres
+// em blocos de 64 KB); as grandes vão direto para o malloc. Tudo é contado
+// por categoria, e qualquer alocação que estoure o orçamento falha (o
+// miniaudio então devolve MA_OUT_OF_MEMORY para quem pediu).
+class AudioMemory {
+public:
+    AudioMemory();
+    ~AudioMemory();
+
+    void setBudget(size_t bytes);
+    ma_allocation_callbacks getCallbacks();
+
+    void* allocate(size_t size, AudioMemCategory category);
+    void* reallocate(void* ptr, size_t size);
+    void release(void* ptr);
+
+    // Memória que não passa pelo alocador (arquivos mapeados)
+    bool reserveMapped(size_t bytes);
+    void releaseMapped(size_t bytes);
+
+    AudioMemoryStats getStats();
+
+    // Categoria usada pelas threads internas do miniaudio (sem Scope próprio)
+    void setDefaultCategory(AudioMemCategory category);
+
+    // Categoria das alocações feitas pela thread atual enquanto o escopo existir
+    class Scope {
+    public:
+        Scope(AudioMemCategory category);
+        ~Scope();
+    private:
+        int previous;
+    };
+
+private:
+    mutex lock;
+    AudioMemoryStats stats;
+    atomic<int> defaultCategory;
+    vector<void*> freeLists;   // uma lista livre por classe de tamanho
+    vector<void*> chunks;      // blocos de 64 KB de onde saem as classes
+
+    bool fitsBudget(size_t extraBytes) const;
+    void* allocateFromPool(int sizeClass);
+    void account(AudioMemCategory category, size_t bytes, bool add);
+    AudioMemCategory categoryForThread() const;
+
+    static void* onMalloc(size_t size, void* userData);
+    static void* onRealloc(void* ptr, size_t size, void* userData);
+    static void onFree(void* ptr, void* userData);
+};
+
+#endif // AUDIOMEMORY_H
@@ -0,0 +1,24 @@
+#ifndef BC7_H
+#define BC7_H
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Compressão BC7 (BPTC) de imagens RGBA8, só no modo 6: blocos 4x4 de 16
+// bytes com um único par de extremos RGBA (7 bits + bit p) e 16 níveis de
+// interpolação. Dá 8 bits por texel (1/4 do RGBA8) e é suportado no núcleo
+// da OpenGL a partir da 4.2 (ou com ARB_texture_compression_bptc).
+
+// Bytes ocupados por uma imagem width x height em BC7
+size_t bc7ImageSize(int width, int height);
+
+// Codifica (offline, no fruitcatcher_cook). Bordas que não completam um
+// bloco repetem a última linha/coluna
+void encodeBC7(const unsigned char* rgba, int width, int height, vector<unsigned char>& blocks);
+
+// Decodifica blocos gerados por encodeBC7 (modo 6), para drivers sem BPTC
+void decodeBC7(const unsigned char* blocks, int width, int height, unsigned char* rgba);
+
+#endif // BC7_H
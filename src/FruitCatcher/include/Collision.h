@@ -0,0 +1,57 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Caixa alinhada aos eixos já com as bordas calculadas (unidades da projeção)
+struct AABB {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+// Caixa de um sprite a partir do centro e das dimensões
+inline AABB makeAABB(float centerX, float centerY, float width, float height)
+{
+    float halfWidth = width * 0.5f;
+    float halfHeight = height * 0.5f;
+    return { centerX - halfWidth, centerY - halfHeight, centerX + halfWidth, centerY + halfHeight };
+}
+
+// Mesma regra do Sprite::checkCollision: bordas que se tocam contam
+inline bool overlaps(const AABB& a, const AABB& b)
+{
+    return a.maxX >= b.minX && b.maxX >= a.minX && a.maxY >= b.minY && b.maxY >= a.minY;
+}
+
+// Caixa que cobre 'box' ao longo de um deslocamento (dx, dy): início e fim
+inline AABB sweptBounds(const AABB& box, float dx, float dy)
+{
+    AABB swept = box;
+    if (dx < 0.0f) swept.minX += dx; else swept.maxX += dx;
+    if (dy < 0.0f) swept.minY += dy; else swept.maxY += dy;
+    return swept;
+}
+
+// Colisão contínua: 'moving' e 'target' estão nas posições do início do passo
+// e se deslocam em linha reta (dx, dy) e (targetDx, targetDy) até o fim dele.
+// Se as caixas se tocam em algum momento do passo, devolve true e o instante
+// do primeiro contato em 'timeOfImpact' (0 = início, 1 = fim; 0 se já
+// começam sobrepostas). Bordas que se tocam contam, como em overlaps
+bool sweepAABB(const AABB& moving, float dx, float dy,
+               const AABB& target, float targetDx, float targetDy, float& timeOfImpact);
+
+// Testa 'box' contra 'count' caixas contíguas, 8 por vez com AVX ou 4 com
+// SSE (escolhido em tempo de execução), e grava o resultado em bits:
+// o bit i % 64 de hits[i / 64] é overlaps(box, boxes[i]). 'hits' precisa de
+// (count + 63) / 64 palavras. Devolve quantas caixas tocam 'box'
+size_t overlapBatch(const AABB& box, const AABB* boxes, size_t count, uint64_t* hits);
+
+// Nome do kernel usado por overlapBatch ("avx", "sse" ou "escalar")
+const char* overlapBatchKernel();
+
+#endif // COLLISION_H
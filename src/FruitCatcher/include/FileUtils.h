@@ -0,0 +1,46 @@
+#ifndef FILEUTILS_H
+#define FILEUTILS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Hash FNV-1a de 64 bits (usado como chave de caches em disco)
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ULL);
+bool hashFile(const string& filePath, uint64_t& outHash);
+string hashToHex(uint64_t hash);
+
+// Leitura/escrita de arquivos inteiros
+bool readFile(const string& filePath, vector<unsigned char>& outData);
+bool writeFileAtomic(const string& filePath, const void* data, size_t size); // escreve em .tmp e renomeia
+bool createDirectories(const string& dirPath);
+
+// Arquivo mapeado em memória (somente leitura)
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const string& filePath);
+    void close();
+
+    const unsigned char* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool isOpen() const { return ptr != nullptr; }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* ptr;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // FILEUTILS_H
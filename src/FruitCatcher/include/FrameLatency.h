@@ -0,0 +1,79 @@
+#ifndef FRAMELATENCY_H
+#define FRAMELATENCY_H
+
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+struct FrameLatencyStats {
+    int samples = 0;
+    float lastMs = 0.0f;     // entrada -> GPU terminou o frame que a mostrou
+    float averageMs = 0.0f;  // das últimas amostras
+    float p95Ms = 0.0f;
+    float maxMs = 0.0f;
+    int queueWaits = 0;      // frames em que a CPU esperou a GPU
+    float queueWaitMs = 0.0f; // no último frame
+};
+
+// Fila de frames entre a CPU e a GPU e quanto a entrada demora a aparecer.
+//
+// Limite da fila: o driver costuma aceitar 2-3 frames à frente da GPU, e cada
+// um é latência a mais entre ler o mouse e mostrar a cesta. Com um limite N,
+// o início de cada frame espera a cerca (glFenceSync) de N frames atrás; no
+// modo glFinish, a CPU espera a GPU esvaziar logo depois de cada swap.
+//
+// Sonda: os callbacks de entrada marcam a hora do primeiro evento ainda não
+// lido; ao ler a entrada (inputSampled) ele passa ao frame atual, e depois do
+// swap um glQueryCounter marca quando a GPU terminou esse frame. A diferença,
+// no relógio da CPU, é a latência entrada -> frame pronto para exibição.
+class FrameLatency {
+public:
+    FrameLatency();
+
+    // queueLimit 0 = fila do driver; useFinish troca as cercas por glFinish
+    void initialize(int queueLimit, bool useFinish, bool probe);
+    void destroy();
+
+    // Callbacks de entrada (mouse, teclado)
+    void onInput();
+
+    // Início do frame, antes de ler a entrada: respeita o limite da fila
+    void waitForQueue();
+
+    // A entrada deste frame foi lida (cesta travada na posição do mouse)
+    void inputSampled();
+
+    // Logo depois do glfwSwapBuffers
+    void endFrame();
+
+    FrameLatencyStats getStats() const;
+
+private:
+    struct PendingFrame {
+        GLsync fence;
+        GLuint query;
+        double inputTime;  // < 0 = frame sem entrada nova
+    };
+
+    int queueLimit;
+    bool useFinish;
+    bool probe;
+    deque<PendingFrame> frames;
+    vector<GLuint> freeQueries;
+    double pendingInput;   // primeiro evento ainda não lido (< 0 = nenhum)
+    double frameInput;     // entrada lida pelo frame atual
+    double gpuToCpu;       // relógio da GPU (GL_TIMESTAMP) -> relógio da CPU, em s
+
+    vector<float> recent;  // últimas latências (anel)
+    size_t recentNext;
+    FrameLatencyStats stats;
+
+    void collect(bool wait);
+    void addSample(float ms);
+};
+
+#endif // FRAMELATENCY_H
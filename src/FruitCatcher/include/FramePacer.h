@@ -0,0 +1,55 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <GLFW/glfw3.h>
+
+using namespace std;
+
+struct FramePacerStats {
+    int targetFps = 0;          // limite em uso (0 = só o vsync)
+    bool vsyncIgnored = false;  // o driver não está esperando o vblank
+    float sleptMs = 0.0f;       // no último frame
+    float spunMs = 0.0f;
+    float idleMs = 0.0f;        // em glfwWaitEventsTimeout
+    float spinMarginMs = 0.0f;  // quanto antes do prazo o sleep termina
+    int lateFrames = 0;         // frames que passaram do prazo
+    int idleFrames = 0;
+};
+
+// Ritmo do game loop. Com VSYNC o glfwSwapBuffers já espera o monitor; com
+// TARGET_FPS (ou se o driver ignorar o vsync) o frame espera o prazo dormindo
+// e depois girando só o último trecho (o sleep do sistema passa do ponto).
+// Quando nada se mexe (menu, game over, janela sem foco ou minimizada), o
+// loop dorme em glfwWaitEventsTimeout até IDLE_FPS ou até chegar um evento.
+class FramePacer {
+public:
+    FramePacer();
+
+    // Com o contexto da janela atual (glfwSwapInterval vale para ele)
+    void initialize(GLFWwindow* window, bool vsync, int targetFps, int idleFps);
+
+    // Chamar logo depois do glfwSwapBuffers
+    void endFrame(bool idle);
+
+    // Em foco e não minimizada
+    bool isWindowActive() const;
+
+    FramePacerStats getStats() const { return stats; }
+
+private:
+    GLFWwindow* window;
+    bool vsync;
+    int targetFps;
+    int idleFps;
+    double refreshPeriod;   // do monitor principal (0 = desconhecido)
+    double nextDeadline;
+    double lastFrameEnd;
+    double spinMargin;      // segundos, ajustado pelo atraso medido dos sleeps
+    int fastSwaps;          // frames seguidos mais rápidos que o monitor com vsync
+    FramePacerStats stats;
+
+    double framePeriod() const;
+    void waitUntil(double deadline);
+};
+
+#endif // FRAMEPACER_H
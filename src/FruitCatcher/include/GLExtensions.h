@@ -0,0 +1,46 @@
+#ifndef GLEXTENSIONS_H
+#define GLEXTENSIONS_H
+
+#include <string>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// A GLAD do projeto foi gerada para OpenGL 4.0 sem extensões. Funções mais
+// novas são carregadas aqui, só se o driver as oferece (núcleo ou extensão ARB)
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+typedef void (APIENTRYP PFNFCTEXSTORAGE2DPROC)(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRYP PFNFCGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNFCPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNFCPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+
+struct GLExtensions {
+    bool textureStorage = false;   // glTexStorage2D (4.2 / ARB_texture_storage)
+    bool compressionBPTC = false;  // texturas BC7 (4.2 / ARB_texture_compression_bptc)
+    bool programBinary = false;    // binários de programa (4.1 / ARB_get_program_binary, com ao menos 1 formato)
+
+    PFNFCTEXSTORAGE2DPROC texStorage2D = nullptr;
+    PFNFCGETPROGRAMBINARYPROC getProgramBinary = nullptr;
+    PFNFCPROGRAMBINARYPROC programBinaryLoad = nullptr;
+    PFNFCPROGRAMPARAMETERIPROC programParameteri = nullptr;
+};
+
+extern GLExtensions glExtensions;
+
+// Chamar depois do gladLoadGLLoader, com o mesmo carregador
+void loadGLExtensions(GLADloadproc loader);
+
+bool hasGLExtension(const string& name);
+
+#endif // GLEXTENSIONS_H
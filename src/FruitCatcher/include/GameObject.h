@@ -2,6 +2,7 @@
 #define GAMEOBJECT_H
 
 #include "Sprite.h"
+#include "MotionBuffer.h"
 
 // Tipos de objetos do jogo
 enum GameObjectType
@@ -11,6 +12,14 @@ enum GameObjectType
     OBJ_INSECT
 };
 
+// Cópia de um objeto para o desenho (motionSlot >= 0: posição na GPU)
+struct ObjectSnapshot
+{
+    SpriteSnapshot sprite;
+    int motionSlot;
+    MotionParams motion;
+};
+
 class GameObject : public Sprite
 {
 public:
@@ -31,11 +40,36 @@ public:
     void setAnimated(bool animated);
     bool isAnimated();
 
+    // Movimento analítico (GPU_MOTION): a partir do spawn, posição e ângulo
+    // são função do tempo de jogo. 'bandY' é a altura em que a base do objeto
+    // entra na faixa de colisão da cesta; antes disso a CPU não o atualiza
+    void startMotion(float time, float bandY);
+    void updateAnalytic(float time);
+    float getBandEnterTime() { return bandEnterTime; }
+    float getSpawnTime() { return spawnTime; }
+    vec3 getSpawnPosition() { return spawnPos; }
+    float getSpawnAngle() { return spawnAngle; }
+    void setMotionSlot(int slot) { motionSlot = slot; }
+    int getMotionSlot() { return motionSlot; }
+
+    // O que vai para o MotionBuffer (rotação zerada nos animados, que não giram)
+    MotionParams getMotionParams() const;
+
+    using Sprite::getSnapshot;
+    void getSnapshot(ObjectSnapshot& out) const;
+
 protected:
     GameObjectType type;
     vec2 velocity; // velocidade em x e y
     float rotationSpeed; // velocidade de rotação (graus por segundo)
     bool animated; // se é um sprite animado (não gira)
+
+    // Movimento analítico
+    float spawnTime;
+    vec3 spawnPos;
+    float spawnAngle;
+    float bandEnterTime; // tempo de jogo em que entra na faixa de colisão
+    int motionSlot;      // slot no MotionBuffer (-1 = desenho com a matriz da CPU)
 };
 
 #endif
@@ -0,0 +1,38 @@
+#ifndef IMAGEOPS_H
+#define IMAGEOPS_H
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+// Operações em imagens RGBA8 (4 bytes por pixel, linhas contíguas) usadas no
+// carregamento de texturas e pelo fruitcatcher_cook. Usam SSE2/SSSE3 ou NEON
+// quando disponível, com uma versão escalar para as demais arquiteturas.
+
+// Preparo de toda textura do jogo, logo após decodificar: RGBA8, alfa
+// pré-multiplicado e linhas de baixo para cima (a ordem da OpenGL)
+
+// RGB -> RGBA com alfa 255 (pixelCount pixels)
+void expandRGBToRGBA(const unsigned char* rgb, unsigned char* rgba, size_t pixelCount);
+
+// Multiplica RGB pelo alfa, no lugar (arredondado, exato em 8 bits)
+void premultiplyAlpha(unsigned char* rgba, size_t pixelCount);
+
+// Inverte a ordem das linhas, no lugar
+void flipRowsRGBA(unsigned char* rgba, int width, int height);
+
+// Reduz a imagem para dstWidth x dstHeight (nunca amplia) com filtro de caixa:
+// cada pixel de destino é a média dos pixels de origem que ele cobre,
+// ponderada pela área coberta
+void resizeRGBA(const unsigned char* src, int srcWidth, int srcHeight,
+                unsigned char* dst, int dstWidth, int dstHeight);
+
+// Próximo nível de mipmap (média 2x2; dimensões ímpares repetem a última linha/coluna)
+void downsampleRGBA(const unsigned char* src, int width, int height,
+                    vector<unsigned char>& dst, int& outWidth, int& outHeight);
+
+// Quantidade de níveis de mipmap até 1x1
+int mipLevelCount(int width, int height);
+
+#endif // IMAGEOPS_H
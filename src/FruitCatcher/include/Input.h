@@ -0,0 +1,95 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+enum InputEventType {
+    INPUT_KEY_DOWN = 1,
+    INPUT_KEY_UP,
+    INPUT_MOUSE_MOVE,
+    INPUT_MOUSE_DOWN,
+    INPUT_MOUSE_UP
+};
+
+// Evento como chega dos callbacks da GLFW, com a hora (glfwGetTime)
+struct InputEvent {
+    double time;
+    int type;
+    int code;   // tecla ou botão
+    float x;    // cursor (só INPUT_MOUSE_MOVE)
+    float y;
+};
+
+// Evento já dentro de um tick da simulação: 'fraction' é o ponto do tick
+// (0 = início, 1 = fim) em que ele aconteceu. É o que o replay grava, então a
+// simulação depende só disto e não do relógio
+struct TickInput {
+    int type;
+    int code;
+    float fraction;
+    float x;
+};
+
+// Fila de um produtor (callbacks da GLFW) e um consumidor (simulação), sem
+// trava: cada lado só escreve o próprio índice
+class InputQueue {
+public:
+    static const size_t CAPACITY = 1024;
+
+    InputQueue();
+
+    // false se a fila está cheia (o evento é descartado e contado)
+    bool push(const InputEvent& event);
+
+    // Tira da fila os eventos com hora <= 'until', em ordem
+    size_t popUntil(double until, vector<InputEvent>& out);
+
+    size_t getDropped() const { return dropped.load(memory_order_relaxed); }
+
+private:
+    InputEvent ring[CAPACITY];
+    atomic<size_t> head;    // próxima leitura (consumidor)
+    atomic<size_t> tail;    // próxima escrita (produtor)
+    atomic<size_t> dropped;
+};
+
+// Estado da entrada visto pela simulação, avançado um tick por vez. Além de
+// "pressionada ou não", mede por quanto do tick cada tecla ficou pressionada:
+// um toque mais curto que um frame (ou um tick) ainda move a cesta
+class InputState {
+public:
+    static const int MAX_KEYS = 512; // GLFW_KEY_LAST é 348
+
+    InputState();
+
+    void reset(float mouseX);
+
+    // Aplica os eventos de um tick, em ordem
+    void applyTick(const vector<TickInput>& events);
+
+    bool isDown(int key) const;
+    float heldFraction(int key) const;      // no último tick, de 0 a 1
+    float getMouseX() const { return mouseX; }
+    bool mouseMoved() const { return moved; } // no último tick
+    bool clicked() const { return click; }    // botão esquerdo no último tick
+
+    // Para o replay: teclas pressionadas no início da partida
+    void getDownKeys(vector<int>& out) const;
+    void setDownKeys(const vector<int>& keys);
+
+private:
+    bool down[MAX_KEYS];
+    float held[MAX_KEYS];
+    float mouseX;
+    bool moved;
+    bool click;
+
+    static bool validKey(int key) { return key >= 0 && key < MAX_KEYS; }
+};
+
+#endif // INPUT_H
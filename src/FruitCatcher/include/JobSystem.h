@@ -0,0 +1,114 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Contador de dependências: cada job associado soma 1 ao ser enviado e
+// subtrai ao terminar. Quem depende do grupo espera (JobSystem::wait) ou
+// agenda uma continuação (JobSystem::runAfter) que sai quando ele zera
+class JobCounter {
+public:
+    JobCounter() : pending(0) {}
+
+    bool isDone() const { return pending.load(memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    struct Continuation {
+        function<void()> task;
+        JobCounter* counter;
+    };
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    atomic<int> pending;
+    mutex lock;
+    vector<Continuation> continuations;
+};
+
+struct JobSystemStats {
+    int workers = 0;
+    uint64_t executed = 0;  // jobs executados (por workers ou por quem espera)
+    uint64_t stolen = 0;    // tirados da fila de outra thread
+};
+
+// Agendador de jobs com roubo de trabalho, um só para o jogo inteiro (em vez
+// de cada sistema abrir as próprias threads). Cada worker tem sua fila: empilha
+// e tira do fim (o trabalho mais recente, ainda no cache) e, sem trabalho,
+// rouba do começo da fila de outra thread. Threads de fora (principal,
+// simulação) enviam para uma fila compartilhada. Quem espera um contador
+// executa os jobs dele enquanto isso, então jobs podem esperar outros jobs
+class JobSystem {
+public:
+    JobSystem();
+    ~JobSystem();
+
+    // workerCount < 0: hardware_concurrency - 1 (a thread que espera também trabalha)
+    void initialize(int workerCount = -1);
+    void shutdown();
+
+    int getWorkerCount() const { return (int)workers.size(); }
+
+    void run(function<void()> task, JobCounter* counter = nullptr);
+
+    // Envia 'task' só quando 'dependency' zerar
+    void runAfter(JobCounter& dependency, function<void()> task, JobCounter* counter = nullptr);
+
+    // Espera o contador zerar, ajudando a executar os jobs dele (só dele)
+    void wait(JobCounter& counter);
+
+    // Divide [0, count) em blocos de até 'grain' itens, executa body(início, fim)
+    // em paralelo e espera todos. Com um só bloco (ou sem workers) roda direto
+    void parallelFor(size_t count, size_t grain, const function<void(size_t, size_t)>& body);
+
+    JobSystemStats getStats() const;
+
+private:
+    struct Job {
+        function<void()> task;
+        JobCounter* counter;
+    };
+
+    struct WorkQueue {
+        mutex lock;
+        deque<Job> jobs;
+    };
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    vector<unique_ptr<WorkQueue>> queues; // 0: threads de fora; 1..N: workers
+    vector<thread> workers;
+
+    mutex sleepLock;
+    condition_variable wake;
+    atomic<int> queued;
+    bool stopping;  // protegido por sleepLock
+
+    atomic<uint64_t> executed;
+    atomic<uint64_t> stolen;
+
+    int currentQueue() const;
+    void push(Job job);
+    bool takeJob(Job& job);
+    bool takeJobOf(const JobCounter& counter, Job& job);
+    bool tryRunOne();
+    void execute(Job& job);
+    void finish(JobCounter* counter);
+    void workerLoop(int queueIndex);
+};
+
+#endif // JOBSYSTEM_H
@@ -0,0 +1,79 @@
+#ifndef MOTIONBUFFER_H
+#define MOTIONBUFFER_H
+
+#include <vector>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+// GLM
+#include <glm/glm.hpp>
+
+using namespace glm;
+
+// Movimento de um objeto a partir do spawn (o que vai para o buffer)
+struct MotionParams {
+    vec3 spawnPos;
+    vec2 velocity;
+    float spawnTime;
+    float spawnAngle;
+    float rotationSpeed;
+    vec3 size;
+};
+
+// Parâmetros do movimento balístico dos objetos que caem, guardados uma única
+// vez (no spawn) num buffer da GPU lido pelo vertex shader como samplerBuffer.
+// O shader calcula posição e ângulo a partir de 'uTime':
+//   posição = início + velocidade * (uTime - tempo do spawn)
+//   ângulo  = ângulo inicial + graus por segundo * (uTime - tempo do spawn)
+// Cada objeto ocupa um slot de MOTION_TEXELS texels RGBA32F.
+//
+// Os slots são distribuídos pela simulação (allocate/remove/clear, sem
+// OpenGL) e o conteúdo é enviado pela thread de desenho (write), que só sobe
+// um slot quando ele muda: na prática, uma vez por objeto
+class MotionBuffer {
+public:
+    static const int MOTION_TEXELS = 3;
+
+    MotionBuffer();
+    ~MotionBuffer();
+
+    // Cria o buffer (cresce sozinho se os slots acabarem)
+    bool initialize(int capacity);
+    void destroy();
+    bool isReady() const { return textureId != 0; }
+
+    // Simulação: reserva um slot (-1 se o buffer não existe)
+    int allocate();
+    void remove(int slot);
+    void clear();
+    int getCount() const { return count; }
+
+    // Desenho: grava o movimento do slot na GPU se ele mudou
+    bool write(int slot, const MotionParams& motion);
+
+    // Liga o buffer na unidade de textura indicada (a ativa volta a ser a 0)
+    void bind(GLuint unit) const;
+
+    int getCapacity() const { return (int)(data.size() / (MOTION_TEXELS * 4)); }
+    size_t getUploadedBytes() const { return uploadedBytes; }
+
+private:
+    GLuint bufferId;
+    GLuint textureId;
+
+    // Lado da simulação
+    vector<int> freeSlots;
+    int slotCapacity;
+    int count;
+
+    // Lado do desenho
+    vector<float> data;     // cópia do buffer, para crescer sem ler da GPU
+    size_t uploadedBytes;   // total enviado desde o início (só no spawn)
+
+    bool grow(int capacity);
+};
+
+#endif // MOTIONBUFFER_H
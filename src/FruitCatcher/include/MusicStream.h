@@ -0,0 +1,117 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <miniaudio.h>
+#include <string>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+enum ThreadPriority {
+    THREAD_PRIORITY_LOW_LEVEL,
+    THREAD_PRIORITY_NORMAL_LEVEL,
+    THREAD_PRIORITY_HIGH_LEVEL
+};
+
+// Parâmetros do streaming da música
+struct MusicStreamConfig {
+    int pageSizeMs = 250;    // quanto áudio cada página decodificada contém
+    int pageCount = 4;       // páginas no buffer (latência de prefetch = pageSizeMs * pageCount)
+    ThreadPriority decodePriority = THREAD_PRIORITY_NORMAL_LEVEL;
+};
+
+struct MusicStreamStats {
+    unsigned long long underruns = 0;      // leituras do mixer que encontraram o buffer sem dados suficientes
+    unsigned long long underrunFrames = 0; // frames preenchidos com silêncio
+    unsigned long long pagesDecoded = 0;
+    double lastPageDecodeMs = 0.0;
+    double avgPageDecodeMs = 0.0;
+    double maxPageDecodeMs = 0.0;
+    double minFillMs = 0.0;                // menor nível do buffer visto pelo mixer
+    double capacityMs = 0.0;
+};
+
+// Stream de música com thread de decodificação própria.
+// A thread decodifica páginas para um ring buffer; o mixer lê do buffer
+// através de um ma_data_source, preenchendo com silêncio (e contando um
+// underrun) se a decodificação ficar para trás.
+class MusicStream {
+public:
+    MusicStream();
+    ~MusicStream();
+
+    bool open(const string& filePath, ma_uint32 channels, ma_uint32 sampleRate,
+              const MusicStreamConfig& config, const ma_allocation_callbacks* allocationCallbacks);
+    // Mesmo stream lendo o arquivo codificado de um bloco de memória (ex.: pacote de assets)
+    bool open(const void* encodedData, size_t encodedSize, ma_uint32 channels, ma_uint32 sampleRate,
+              const MusicStreamConfig& config, const ma_allocation_callbacks* allocationCallbacks);
+    void close();
+    bool isOpen() const { return opened; }
+
+    ma_data_source* dataSource() { return &source; }
+    void setLooping(bool loop) { looping = loop; }
+    void rewind(); // volta ao início; o mixer descarta o que já estava no buffer
+
+    MusicStreamStats getStats() const;
+
+private:
+    // ma_data_source_base precisa ser o primeiro membro do objeto passado ao miniaudio
+    struct Source {
+        ma_data_source_base base;
+        MusicStream* owner;
+    };
+
+    Source source;
+    ma_decoder decoder;
+    ma_pcm_rb ringBuffer;
+    MusicStreamConfig config;
+    ma_uint32 channels;
+    ma_uint32 sampleRate;
+    ma_uint32 pageFrames;
+    bool opened;
+
+    thread decodeThread;
+    atomic<bool> running;
+    atomic<bool> looping;
+    atomic<bool> reachedEnd;
+
+    // Buscas: o mixer e rewind() só fazem o pedido; a thread de decodificação
+    // move o decodificador e marca até onde o buffer ficou obsoleto
+    static constexpr ma_uint64 NO_SEEK = ~(ma_uint64)0;
+    atomic<ma_uint64> seekRequest;
+    atomic<ma_uint64> framesWritten;  // total escrito no buffer (thread de decodificação)
+    atomic<ma_uint64> discardUntil;   // frames escritos antes da última busca
+    ma_uint64 readCursor;             // total consumido do buffer (thread do mixer)
+
+    // Contadores (escritos pela thread de decodificação e pela do mixer)
+    atomic<unsigned long long> underruns;
+    atomic<unsigned long long> underrunFrames;
+    atomic<unsigned long long> pagesDecoded;
+    atomic<unsigned long long> decodeNanosTotal;
+    atomic<unsigned long long> decodeNanosMax;
+    atomic<unsigned long long> decodeNanosLast;
+    atomic<ma_uint32> minFillFrames;
+
+    void prepare(ma_uint32 channels, ma_uint32 sampleRate, const MusicStreamConfig& config);
+    bool start(const ma_allocation_callbacks* allocationCallbacks);
+    bool decodePage();
+    void applySeek();
+    void decodeLoop();
+    void startThread();
+    void stopThread();
+    void resetStats();
+
+    static ma_result onRead(ma_data_source* dataSource, void* framesOut, ma_uint64 frameCount, ma_uint64* framesRead);
+    static ma_result onSeek(ma_data_source* dataSource, ma_uint64 frameIndex);
+    static ma_result onGetDataFormat(ma_data_source* dataSource, ma_format* format, ma_uint32* channels,
+                                     ma_uint32* sampleRate, ma_channel* channelMap, size_t channelMapCap);
+    static ma_result onGetCursor(ma_data_source* dataSource, ma_uint64* cursor);
+    static ma_result onGetLength(ma_data_source* dataSource, ma_uint64* length);
+    static ma_result onSetLooping(ma_data_source* dataSource, ma_bool32 isLooping);
+};
+
+bool setCurrentThreadPriority(ThreadPriority priority);
+ThreadPriority parseThreadPriority(const string& text);
+
+#endif // MUSICSTREAM_H
@@ -0,0 +1,47 @@
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include <GLFW/glfw3.h>
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+// Overlay de desempenho (F3). O jogo não tem renderização de texto, então
+// as métricas são mostradas no título da janela, atualizado duas vezes por
+// segundo. Qualquer sistema pode publicar um valor com set().
+class PerfOverlay {
+public:
+    PerfOverlay();
+
+    void initialize(GLFWwindow* window, const string& baseTitle, bool enabled = false);
+    void toggle();
+    bool isEnabled() const { return enabled; }
+
+    // Chamar uma vez por frame com o tempo do frame em segundos
+    void frame(float deltaTime);
+
+    // Publica (ou atualiza) uma métrica mostrada no overlay
+    void set(const string& name, const string& value);
+
+    // Reescreve o título se o intervalo de atualização passou
+    void update();
+
+private:
+    GLFWwindow* window;
+    string baseTitle;
+    bool enabled;
+
+    vector<pair<string, string>> values; // em ordem de inserção
+    int frames;
+    float accumulatedTime;
+    float fps;
+    float avgFrameMs;
+    float maxFrameMs;
+    double lastRefresh;
+
+    void refreshTitle();
+};
+
+#endif // PERFOVERLAY_H
@@ -0,0 +1,84 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Input.h"
+
+using namespace std;
+
+// Replay de uma partida: o estado inicial mais os eventos de entrada de cada
+// tick da simulação. Com a mesma semente e o mesmo passo fixo, reaplicar os
+// eventos reproduz a partida; o placar gravado no fim confere o resultado
+
+struct ReplayHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t seed;
+    float tickRate;         // ticks por segundo
+    uint32_t gpuMotion;     // o modo de movimento muda a ordem dos cálculos
+    float basketX;
+    float mouseX;
+    uint32_t useMouseControl;
+    uint32_t downKeyCount;  // seguido de downKeyCount int32 com as teclas pressionadas
+};
+
+struct ReplayRecord {
+    uint32_t tick;
+    int32_t type;           // InputEventType ou REPLAY_END
+    int32_t code;
+    float fraction;
+    float x;
+};
+
+// Último registro: tick final, placar (code) e vidas (x)
+static const int32_t REPLAY_END = 100;
+
+class ReplayWriter {
+public:
+    ReplayWriter();
+
+    void begin(const ReplayHeader& header, const vector<int>& downKeys);
+    void record(uint32_t tick, const vector<TickInput>& events);
+
+    // Fecha a partida e grava o arquivo
+    bool finish(const string& filePath, uint32_t tick, int score, int lives);
+
+    bool isRecording() const { return recording; }
+
+private:
+    bool recording;
+    size_t eventCount;
+    vector<unsigned char> data;
+};
+
+class ReplayReader {
+public:
+    ReplayReader();
+
+    bool load(const string& filePath);
+
+    const ReplayHeader& getHeader() const { return header; }
+    const vector<int>& getDownKeys() const { return downKeys; }
+
+    // Eventos do tick (os ticks são lidos em ordem)
+    void eventsForTick(uint32_t tick, vector<TickInput>& out);
+
+    uint32_t getEndTick() const { return endTick; }
+    int getFinalScore() const { return finalScore; }
+    int getFinalLives() const { return finalLives; }
+
+private:
+    ReplayHeader header;
+    vector<int> downKeys;
+    vector<ReplayRecord> records;
+    size_t cursor;
+    uint32_t endTick;
+    int finalScore;
+    int finalLives;
+};
+
+#endif // REPLAY_H
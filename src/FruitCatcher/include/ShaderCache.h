@@ -0,0 +1,57 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "FileUtils.h"
+
+using namespace std;
+
+// Cabeçalho dos arquivos .bin do cache (binário do driver logo após)
+struct ShaderCacheHeader {
+    char magic[8];         // "FCSHADER"
+    uint32_t version;
+    uint32_t binaryFormat; // formato devolvido por glGetProgramBinary
+    uint64_t binaryLength;
+    uint64_t key;          // hash dos fontes + GL_VENDOR/GL_RENDERER/GL_VERSION
+};
+
+struct ShaderCacheStats {
+    int hits = 0;      // programas carregados do binário
+    int misses = 0;    // programas compilados (sem binário no disco)
+    int rejected = 0;  // binários recusados pelo driver (atualização, outra GPU...)
+    double lastLoadMs = 0.0;
+};
+
+// Cache em disco de programas já linkados (glGetProgramBinary).
+// A chave inclui os fontes e a identificação do driver, então trocar de GPU
+// ou atualizar o driver só gera um novo arquivo. Se o driver recusar o
+// binário, o arquivo é apagado e o programa é compilado normalmente.
+class ShaderCache {
+public:
+    ShaderCache();
+
+    void setDirectory(const string& dir);
+    const string& getDirectory() const { return directory; }
+
+    // Devolve o programa linkado (0 se a compilação falhar)
+    GLuint loadProgram(const char* vertexSource, const char* fragmentSource);
+
+    const ShaderCacheStats& getStats() const { return stats; }
+
+private:
+    string directory;
+    ShaderCacheStats stats;
+
+    uint64_t keyFor(const char* vertexSource, const char* fragmentSource) const;
+    string cachePathFor(uint64_t key) const;
+    GLuint loadBinary(const string& cachePath, uint64_t key);
+    void saveBinary(GLuint program, const string& cachePath, uint64_t key);
+    GLuint compileProgram(const char* vertexSource, const char* fragmentSource, bool retrievable);
+};
+
+#endif // SHADERCACHE_H
@@ -0,0 +1,99 @@
+#ifndef SHAREDASSETCACHE_H
+#define SHAREDASSETCACHE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// Cabeçalho do segmento de memória compartilhada (índice e pixels logo após)
+struct SharedCacheHeader {
+    char magic[8];          // "FCSHARED"
+    uint32_t version;
+    uint32_t ready;         // 0 enquanto o criador escreve, 1 quando pode ser lido
+    uint64_t key;           // hash do pacote de assets (e da versão do formato)
+    uint64_t creatorPid;    // para descartar segmentos de um processo que morreu
+    uint32_t entryCount;    // entradas ordenadas por 'key', logo após o cabeçalho
+    uint32_t reserved;
+    uint64_t totalSize;
+};
+
+// Imagem RGBA8 pré-multiplicada no segmento: 'levels' mipmaps em sequência
+struct SharedImageEntry {
+    uint64_t key;           // sharedImageKey()
+    uint64_t contentHash;   // o mesmo do TextureCache (para compartilhar texturas iguais)
+    uint32_t width;         // nível 0
+    uint32_t height;
+    uint32_t levels;
+    uint32_t reserved;
+    uint64_t dataOffset;    // a partir do início do segmento (alinhado a 64 bytes)
+    uint64_t dataSize;
+};
+
+// Texturas decodificadas uma única vez por máquina. Vários processos do jogo
+// na mesma máquina (demonstrações, testes automáticos) compartilham um
+// segmento POSIX (shm_open, só do usuário) cujo nome vem do usuário e do hash
+// do pacote de assets:
+//  - o primeiro processo decodifica normalmente, guarda uma cópia de cada
+//    imagem e publica o segmento quando termina de carregar;
+//  - os seguintes o mapeiam somente leitura e enviam as texturas direto dele.
+// O segmento sobrevive ao processo (como um cache); um pacote novo gera outro
+// nome. Fora de sistemas POSIX tudo vira no-op.
+class SharedAssetCache {
+public:
+    SharedAssetCache();
+    ~SharedAssetCache();
+
+    // Mapeia o segmento deste pacote, se existir; senão passa a gravar
+    bool open(uint64_t packHash);
+    void close();
+
+    bool isAttached() const { return header != nullptr; }
+    bool isRecording() const { return recording; }
+    const string& getName() const { return name; }
+
+    // Busca somente leitura (pode ser chamada de qualquer thread)
+    const SharedImageEntry* find(uint64_t key) const;
+    const unsigned char* entryData(const SharedImageEntry& entry) const;
+
+    // Guarda uma cópia da imagem para publicar (thread-safe)
+    void record(uint64_t key, uint64_t contentHash, int width, int height, int levels,
+                const unsigned char* pixels, size_t size);
+    // Cria o segmento com tudo que foi gravado; depois disso para de gravar
+    bool publish();
+
+    size_t getSize() const { return mappedSize; }
+    int getEntryCount() const { return header != nullptr ? (int)header->entryCount : 0; }
+
+private:
+    struct PendingImage {
+        uint64_t contentHash;
+        int width;
+        int height;
+        int levels;
+        vector<unsigned char> pixels;
+    };
+
+    string name;
+    uint64_t key;
+    const SharedCacheHeader* header;
+    const SharedImageEntry* entries;
+    size_t mappedSize;
+    bool recording;
+    mutex pendingLock;
+    map<uint64_t, PendingImage> pending; // ordenado pela chave, como o índice
+
+    bool attach();
+};
+
+// Chave de uma imagem decodificada de arquivo: caminho, tamanho, data de
+// modificação e limite de tamanho (sem precisar ler o arquivo)
+uint64_t sharedImageKey(const string& filePath, int maxWidth, int maxHeight);
+// Chave de uma textura BC7 do pacote descomprimida a partir de 'firstLevel'
+uint64_t sharedPackedKey(uint64_t sourceHash, int firstLevel);
+
+#endif // SHAREDASSETCACHE_H
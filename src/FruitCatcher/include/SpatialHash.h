@@ -0,0 +1,59 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "Collision.h"
+
+using namespace std;
+
+// Broadphase em grade uniforme. Cada caixa entra em todas as células que
+// toca; as células vão para uma tabela de tamanho fixo (hash das coordenadas)
+// ordenada por contagem, então reconstruir a cada tick custa O(n) e não
+// aloca depois da primeira vez. As consultas devolvem candidatos: o teste
+// AABB exato continua com quem chama.
+//
+// Com células do tamanho dos objetos, cada caixa ocupa de 1 a 4 células.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 64.0f);
+
+    void setCellSize(float size);
+    float getCellSize() const { return cellSize; }
+
+    // Reconstrói a grade; os índices devolvidos são posições em 'boxes'
+    void build(const vector<AABB>& boxes);
+
+    // Caixas que podem tocar 'box' (sem repetição, em ordem crescente)
+    void query(const AABB& box, vector<uint32_t>& out) const;
+
+    // Pares (i < j) que podem se tocar, cada par uma única vez
+    void findPairs(vector<pair<uint32_t, uint32_t>>& out) const;
+
+    size_t getCellEntryCount() const { return cells.size(); }
+
+private:
+    struct CellEntry {
+        int32_t cellX;
+        int32_t cellY;
+        uint32_t index;
+    };
+
+    float cellSize;
+    float inverseCellSize;
+    const vector<AABB>* boxes;
+    vector<CellEntry> scratch;          // entradas na ordem de inserção
+    vector<CellEntry> cells;            // ordenadas por balde
+    vector<uint32_t> bucketStart;       // início de cada balde em 'cells' (+1 no fim)
+    vector<uint32_t> cursor;            // posição de escrita de cada balde no build
+    uint32_t bucketMask;
+    mutable vector<uint32_t> stamps;    // evita repetir um índice na mesma consulta
+    mutable uint32_t stamp;
+
+    int32_t cellCoord(float value) const;
+    uint32_t bucketOf(int32_t cellX, int32_t cellY) const;
+};
+
+#endif // SPATIALHASH_H
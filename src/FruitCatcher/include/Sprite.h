@@ -20,6 +20,22 @@ using namespace std;
 
 using namespace glm;
 
+#include "Collision.h"
+
+// O que é preciso para desenhar um sprite, copiado do objeto: a thread de
+// desenho usa a cópia enquanto a simulação continua mexendo no original
+struct SpriteSnapshot
+{
+    GLuint texID;
+    vec3 pos;
+    vec3 dimensions;
+    float angle;
+    int nAnimations, nFrames;
+    int iAnimation;
+    float animationStart, FPS;
+    bool isActive;
+};
+
 class Sprite
 {
 public:
@@ -39,10 +55,18 @@ public:
 
     // Para colisão AABB (Axis-Aligned Bounding Box)
     bool checkCollision(Sprite& other);
+    AABB getBounds() const { return makeAABB(pos.x, pos.y, dimensions.x, dimensions.y); }
 
     // Controle de animação
     void setAnimation(int animIndex);
     void setFPS(float fps);
+    // Tempo (no relógio 'uTime' do shader) em que a animação está no frame 0
+    void setAnimationStart(float time);
+
+    // Cópia para o desenho e o desenho a partir dela. Com motionSlot >= 0 a
+    // posição vem do MotionBuffer (vertex shader) e não de 'pos'/'angle'
+    void getSnapshot(SpriteSnapshot& out) const;
+    static void drawSnapshot(GLuint shaderID, const SpriteSnapshot& snapshot, int motionSlot = -1);
 
     // Estado do sprite
     bool isActive;
@@ -57,11 +81,18 @@ protected:
 
     // Animação
     int nAnimations, nFrames;
-    int iAnimation, iFrame;
+    int iAnimation;
     vec2 d; // dimensões do frame na textura
-    float lastTime, FPS;
+    float animationStart, FPS;
+
+    // Quad da grade da spritesheet, compartilhado e criado no primeiro
+    // desenho (initialize não chama OpenGL e pode rodar na simulação)
+    static GLuint geometryFor(int nAnimations, int nFrames);
 
-    GLuint setupGeometry();
+    // Linha da animação e parâmetros do frame calculado no shader
+    void updateAnimation();
+    static void setAnimationUniforms(GLuint shaderID, int iAnimation, int nAnimations, int nFrames,
+                                     float animationStart, float fps);
 };
 
 #endif
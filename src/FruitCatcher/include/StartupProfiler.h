@@ -0,0 +1,63 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace std;
+
+// Uma fase da inicialização: tempo de relógio e de CPU da thread principal
+struct StartupPhase {
+    string name;
+    double startMs = 0.0;  // desde a entrada no main
+    double wallMs = 0.0;
+    double cpuMs = 0.0;
+};
+
+// Mede a inicialização da entrada no main até o primeiro frame apresentado.
+// Cada beginPhase() encerra a fase anterior; finish() encerra a última e
+// fixa o total. O relatório sai em JSON (para comparar execuções) e em texto.
+class StartupProfiler {
+public:
+    StartupProfiler();
+
+    void start();
+    void beginPhase(const string& name);
+    void finish();
+
+    bool isFinished() const { return finished; }
+    const vector<StartupPhase>& getPhases() const { return phases; }
+    double getTotalMs() const { return totalMs; }
+    double getTotalCpuMs() const { return totalCpuMs; }
+
+    // Grava <base>.json e <base>.txt e imprime o resumo
+    bool writeReport(const string& basePath) const;
+
+    // Acrescenta as fases desta execução a um arquivo do --startup-bench
+    bool appendRun(const string& runsPath) const;
+
+private:
+    chrono::steady_clock::time_point startTime;
+    double startCpuMs;
+    double phaseStartMs;
+    double phaseStartCpuMs;
+    bool started;
+    bool finished;
+    double totalMs;
+    double totalCpuMs;
+    vector<StartupPhase> phases;
+
+    double elapsedMs() const;
+    void endPhase();
+    string formatText() const;
+};
+
+// Tempo de CPU da thread atual, em ms
+double threadCpuTimeMs();
+
+// --startup-bench N: reinicia o executável N vezes (com --startup-run, que
+// fecha após o primeiro frame) e relata min/mediana/p90/máx de cada fase
+int runStartupBenchmark(const string& executable, int runs, const string& basePath);
+
+#endif // STARTUPPROFILER_H
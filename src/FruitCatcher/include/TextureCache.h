@@ -0,0 +1,111 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+#include "AssetPack.h"
+#include "SharedAssetCache.h"
+
+// Textura residente na GPU, compartilhada por todos que a pediram
+struct CachedTexture {
+    GLuint id = 0;
+    int width = 0;              // dimensões na GPU (podem ser menores que as do arquivo)
+    int height = 0;
+    GLenum format = GL_RGBA8;   // formato interno na GPU (GL_RGBA8 ou BC7)
+    size_t bytes = 0;           // memória de vídeo estimada (com mipmaps)
+    int refCount = 0;
+    string key;                 // caminho normalizado (ou "color:RRGGBBAA")
+    uint64_t contentHash = 0;
+};
+
+// Imagem de arquivo já decodificada e preparada (RGBA8 pré-multiplicado, de
+// baixo para cima, no tamanho final), faltando só o envio para a GPU
+struct PreparedImage {
+    string path;
+    int maxWidth = 0;
+    int maxHeight = 0;
+    uint64_t contentHash = 0;   // hash do arquivo combinado com o limite de tamanho
+    int width = 0;
+    int height = 0;
+    vector<unsigned char> pixels;
+};
+
+struct TextureCacheStats {
+    int textures = 0;
+    size_t bytesResident = 0;
+    unsigned long long loads = 0;       // decodificações/envios reais
+    unsigned long long pathHits = 0;    // pedidos pelo mesmo caminho
+    unsigned long long contentHits = 0; // caminhos diferentes com o mesmo conteúdo
+};
+
+// Cache de texturas por caminho normalizado e hash do conteúdo. Cada textura
+// é decodificada e enviada uma única vez; quem pede de novo recebe a mesma
+// (com a contagem de referências incrementada). Ao chegar a zero referências
+// a textura é apagada da GPU.
+//
+// Quem sabe o maior tamanho em que a textura aparece na tela pode pedir um
+// limite: a imagem é reduzida (filtro de caixa) antes do envio, ou, no pacote,
+// o envio começa no primeiro mipmap que ainda cobre esse tamanho.
+//
+// Todas as texturas ficam em RGBA8 (ou BC7) com alfa pré-multiplicado e a
+// primeira linha na base da imagem (a orientação da OpenGL).
+class TextureCache {
+public:
+    TextureCache();
+    ~TextureCache();
+
+    // Pacote de assets consultado antes dos arquivos originais
+    void setAssetPack(const AssetPack* pack) { assetPack = pack; }
+    // Imagens já decodificadas por outro processo (e onde publicar as daqui)
+    void setSharedCache(SharedAssetCache* cache) { shared = cache; }
+
+    // nullptr se o arquivo não existe ou não pôde ser decodificado.
+    // maxWidth/maxHeight = 0: tamanho original
+    const CachedTexture* acquire(const string& filePath, int maxWidth = 0, int maxHeight = 0);
+    // Envia uma imagem preparada por prepareImage (ou reaproveita uma textura
+    // igual que já esteja no cache)
+    const CachedTexture* acquirePrepared(const PreparedImage& image);
+    // Verdadeiro se a textura sai do pacote ou do cache compartilhado (sem
+    // decodificação a fazer)
+    bool canUploadDirectly(const string& filePath, int maxWidth, int maxHeight) const;
+
+    // Lê e decodifica um arquivo sem tocar na OpenGL nem no cache: pode rodar
+    // em qualquer thread
+    static bool prepareImage(const string& filePath, int maxWidth, int maxHeight, PreparedImage& out);
+    // Textura 1x1 de uma cor (compartilhada entre quem pede a mesma cor).
+    // A cor é passada com alfa normal e guardada pré-multiplicada
+    const CachedTexture* acquireSolidColor(float r, float g, float b, float a);
+
+    void retain(const CachedTexture* texture);
+    void release(const CachedTexture* texture);
+    const CachedTexture* findById(GLuint id) const;
+
+    TextureCacheStats getStats() const { return stats; }
+    void clear(); // apaga tudo (precisa do contexto OpenGL ainda ativo)
+
+private:
+    const AssetPack* assetPack;
+    SharedAssetCache* shared;
+    bool bptcWarned;
+    map<string, CachedTexture*> byPath;
+    map<uint64_t, CachedTexture*> byContent;
+    TextureCacheStats stats;
+
+    CachedTexture* share(CachedTexture* texture, const string& key);
+    CachedTexture* uploadPacked(const PackEntry& packed, int maxWidth, int maxHeight);
+    CachedTexture* uploadRGBA(const unsigned char* pixels, int width, int height);
+    void recordShared(const PreparedImage& image);
+    void insert(CachedTexture* texture, const string& key, uint64_t contentHash);
+    void destroy(CachedTexture* texture);
+};
+
+#endif // TEXTURECACHE_H
@@ -0,0 +1,70 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+#include "TextureCache.h"
+#include "JobSystem.h"
+
+// Resultado de uma decodificação (ok = false se o arquivo falhou)
+struct TextureLoadResult {
+    GLuint handle = 0;
+    bool ok = false;
+    PreparedImage image;
+};
+
+// Lê e decodifica texturas (TextureCache::prepareImage) em jobs do
+// JobSystem, no máximo 'maxConcurrent' ao mesmo tempo, fora da thread
+// principal. O envio para a GPU continua na thread do contexto: ela busca os
+// resultados prontos com poll() ou wait().
+class TextureLoader {
+public:
+    TextureLoader();
+    ~TextureLoader();
+
+    // Sem workers no JobSystem não há onde decodificar: fica parado
+    void start(JobSystem* jobSystem, int maxConcurrent);
+    void stop();
+    bool isRunning() const { return jobSystem != nullptr; }
+
+    void submit(GLuint handle, const string& filePath, int maxWidth, int maxHeight);
+
+    // Pega um resultado pronto (não bloqueia)
+    bool poll(TextureLoadResult& out);
+    // Espera até haver um resultado; false se não há nada pendente
+    bool wait(TextureLoadResult& out);
+
+    int getPending() const;
+
+private:
+    struct Job {
+        GLuint handle;
+        string path;
+        int maxWidth;
+        int maxHeight;
+    };
+
+    JobSystem* jobSystem;
+    JobCounter running;  // jobs de decodificação no JobSystem
+    int maxConcurrent;
+    int active;          // jobs em execução (<= maxConcurrent)
+    mutable mutex lock;
+    condition_variable resultReady;
+    deque<Job> jobs;
+    deque<TextureLoadResult> results;
+    int inFlight;  // enviados e ainda não devolvidos por poll/wait
+    bool stopping;
+
+    void decodeOne();
+};
+
+#endif // TEXTURELOADER_H
@@ -0,0 +1,134 @@
+#ifndef TEXTURERESIDENCY_H
+#define TEXTURERESIDENCY_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <cstddef>
+
+using namespace std;
+
+// GLAD
+#include <glad/glad.h>
+
+#include "TextureCache.h"
+#include "TextureLoader.h"
+
+// Cenas em que uma textura é usada (combináveis)
+enum SceneTag {
+    SCENE_MENU = 1,
+    SCENE_PLAYING = 2,
+    SCENE_GAME_OVER = 4,
+    SCENE_ALL = SCENE_MENU | SCENE_PLAYING | SCENE_GAME_OVER
+};
+
+struct TextureResidencyStats {
+    int declared = 0;
+    int resident = 0;
+    int decoding = 0;                   // nas threads de decodificação
+    size_t bytesResident = 0;           // memória de vídeo de todas as texturas do cache
+    size_t budgetBytes = 0;             // 0 = sem limite
+    unsigned long long loads = 0;
+    unsigned long long evictions = 0;
+    unsigned long long stubBinds = 0;   // desenhos feitos com a textura provisória
+};
+
+// Gerencia quais texturas ficam na GPU. O jogo recebe handles (não IDs da
+// OpenGL) que só viram texturas reais na hora do bind: a textura é carregada
+// no primeiro uso (ou antes, quando a cena dela fica ativa) e, se o orçamento
+// de memória estourar, as menos usadas recentemente saem da GPU, começando
+// pelas que não pertencem à cena atual. Enquanto uma textura (re)carrega, o
+// bind usa uma textura provisória de 1x1 com a cor média dela.
+//
+// Com threads de decodificação, arquivos fora do pacote são lidos e
+// decodificados nelas; a thread principal só envia o resultado para a GPU.
+class TextureResidency {
+public:
+    TextureResidency();
+
+    void initialize(TextureCache* cache, const AssetPack* pack);
+    void setBudget(size_t bytes) { stats.budgetBytes = bytes; }
+    void setStreamTimePerFrame(double ms) { streamMsPerFrame = ms; }
+    // Decodificações simultâneas no JobSystem (0 ou sem workers = na
+    // thread principal, dentro do tempo por frame)
+    void setLoaderThreads(int count, JobSystem* jobSystem);
+
+    // Registra uma textura sem carregá-la; 0 se o arquivo não existe.
+    // maxWidth/maxHeight: maior tamanho (em pixels) em que ela é desenhada,
+    // 0 = tamanho original. Declarações repetidas ficam com o maior
+    GLuint declare(const string& filePath, unsigned int scenes, int maxWidth = 0, int maxHeight = 0);
+    // Cor sólida: carregada na hora e nunca removida
+    GLuint declareSolidColor(float r, float g, float b, float a);
+    // Marca o handle como usado também nestas cenas
+    void addScenes(GLuint handle, unsigned int scenes);
+    // Dimensões do arquivo original (não as da textura reduzida)
+    bool getSize(GLuint handle, int& width, int& height) const;
+
+    // Chamar no início de cada frame: carrega o que está na fila (dentro do
+    // tempo por frame) e aplica o orçamento
+    void beginFrame(unsigned int scene);
+
+    // Torna a cena atual e só retorna com todas as texturas dela na GPU
+    // (usado para apresentar o menu completo já no primeiro frame)
+    void loadSceneNow(unsigned int scene);
+    // Todas as texturas da cena estão na GPU (ou falharam, ou só caberão no
+    // orçamento quando a cena ficar ativa)
+    bool isSceneReady(unsigned int scene) const;
+
+    // Resolve o handle e faz o glBindTexture (textura provisória se não residente)
+    void bind(GLuint handle);
+
+    TextureResidencyStats getStats() const;
+    void clear();
+
+private:
+    struct Entry {
+        string path;
+        unsigned int scenes = 0;
+        const CachedTexture* texture = nullptr; // nullptr = fora da GPU
+        GLuint stubId = 0;                      // cor média (depois do primeiro carregamento)
+        int width = 0;
+        int height = 0;
+        int maxWidth = 0;                       // limite de tamanho pedido (0 = original)
+        int maxHeight = 0;
+        bool compressed = false;                // BC7 do pacote (1 byte por texel na GPU)
+        size_t estimatedBytes = 0;
+        unsigned long long lastUsedFrame = 0;
+        bool queued = false;
+        bool decoding = false;                  // enviada ao TextureLoader
+        bool failed = false;                    // arquivo ilegível: não tenta de novo
+        bool pinned = false;
+    };
+
+    TextureCache* cache;
+    const AssetPack* assetPack;
+    vector<Entry> entries;            // handle = índice + 1
+    map<string, GLuint> handlesByPath;
+    deque<GLuint> loadQueue;
+    TextureLoader loader;
+    int loaderThreads;
+    size_t decodingBytes;             // estimativa das texturas nas threads
+    unsigned int currentScene;
+    unsigned long long frame;
+    double streamMsPerFrame;
+    GLuint defaultStubId;
+    bool budgetWarned;
+    TextureResidencyStats stats;
+
+    void queue(GLuint handle, bool urgent);
+    bool load(GLuint handle);
+    bool startDecode(GLuint handle);
+    void finishDecode(TextureLoadResult& result);
+    void reserve(const Entry& entry);
+    void evict(GLuint handle);
+    bool makeRoom(size_t bytes, bool allowCurrentScene);
+    GLuint pickVictim(bool allowCurrentScene) const;
+    void prefetchIdle();
+};
+
+// Bind por handle usado por Sprite e pelas funções de desenho. Sem um
+// TextureResidency ativo, o handle é tratado como ID da OpenGL.
+void bindTexture(GLuint handle);
+
+#endif // TEXTURERESIDENCY_H
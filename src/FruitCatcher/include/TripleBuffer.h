@@ -0,0 +1,48 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+using namespace std;
+
+// Três cópias de T entre um produtor e um consumidor, sem trava: o produtor
+// escreve numa, o consumidor lê outra e a terceira guarda a última publicada.
+// Nenhum lado espera o outro; o consumidor sempre pega a versão mais nova e
+// as intermediárias que ele não chegou a ver são descartadas. As cópias são
+// reaproveitadas (vetores dentro de T mantêm a capacidade entre publicações)
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), middle(1), front(2)
+    {
+    }
+
+    // Produtor: preenche writeBuffer() e publica
+    T& writeBuffer() { return buffers[back]; }
+
+    void publish()
+    {
+        back = middle.exchange(back | FRESH, memory_order_acq_rel) & INDEX;
+    }
+
+    // Consumidor: true se havia versão nova (readBuffer() passa a ser ela)
+    bool acquire()
+    {
+        if ((middle.load(memory_order_relaxed) & FRESH) == 0) return false;
+        front = middle.exchange(front, memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    const T& readBuffer() const { return buffers[front]; }
+
+private:
+    static const int INDEX = 3;
+    static const int FRESH = 4;
+
+    T buffers[3];
+    int back;           // só o produtor
+    atomic<int> middle; // índice + FRESH se ainda não foi lido
+    int front;          // só o consumidor
+};
+
+#endif // TRIPLEBUFFER_H
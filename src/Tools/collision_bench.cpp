@@ -0,0 +1,131 @@
+/*
+ * collision_bench
+ *
+ * Mede a detecção de colisão com 10 a 100 mil objetos do tamanho dos do
+ * jogo (50x50), espalhados com a densidade de uma tela cheia:
+ *   - cesta x todos: teste linear, teste em lote (overlapBatch, SIMD) e
+ *     consulta na grade (SpatialHash)
+ *   - todos x todos: pares candidatos da grade + teste exato (a força bruta
+ *     O(n²) só é medida até 10 mil objetos)
+ *
+ * Uso: collision_bench [repetições]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+using namespace std;
+
+#include "Collision.h"
+#include "SpatialHash.h"
+
+static const float OBJECT_SIZE = 50.0f;
+static const float OBJECTS_PER_SCREEN = 40.0f; // 800x800 com ~40 objetos
+static const size_t BRUTE_FORCE_LIMIT = 10000;
+
+template <typename Function>
+static double measureMs(int repetitions, Function function)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repetitions;
+}
+
+int main(int argc, char** argv)
+{
+    int repetitions = argc > 1 ? max(1, atoi(argv[1])) : 20;
+    mt19937 random(1234);
+
+    cout << "Kernel do teste em lote: " << overlapBatchKernel() << endl;
+    cout << fixed << setprecision(4);
+    cout << setw(8) << "objetos" << setw(12) << "cesta lin" << setw(12) << "cesta lote" << setw(12) << "cesta grade"
+         << setw(12) << "build" << setw(13) << "pares grade" << setw(13) << "força bruta"
+         << setw(10) << "pares" << setw(10) << "candid." << "   (ms por tick)" << endl;
+
+    for (size_t count = 10; count <= 100000; count *= 10) {
+        for (size_t scaled : {count, count * 3}) {
+            if (scaled > 100000) break;
+
+            // Mesma densidade do jogo: a área cresce com o número de objetos
+            float side = 800.0f * sqrt(scaled / OBJECTS_PER_SCREEN);
+            uniform_real_distribution<float> coordinate(0.0f, side);
+            vector<AABB> boxes(scaled);
+            for (AABB& box : boxes) {
+                box = makeAABB(coordinate(random), coordinate(random), OBJECT_SIZE, OBJECT_SIZE);
+            }
+            AABB basket = makeAABB(side / 2.0f, 50.0f, 80.0f, 60.0f);
+
+            SpatialHash grid(64.0f);
+            vector<uint32_t> candidates;
+            vector<pair<uint32_t, uint32_t>> pairs;
+            vector<uint64_t> hits((scaled + 63) / 64);
+            volatile size_t sink = 0;
+
+            size_t linearHits = 0, batchHits = 0;
+            double linearMs = measureMs(repetitions, [&] {
+                linearHits = 0;
+                for (const AABB& box : boxes) linearHits += overlaps(basket, box);
+                sink += linearHits;
+            });
+            double batchMs = measureMs(repetitions, [&] {
+                batchHits = overlapBatch(basket, boxes.data(), boxes.size(), hits.data());
+                sink += batchHits;
+            });
+            size_t maskHits = 0;
+            for (size_t i = 0; i < scaled; i++) {
+                bool expected = overlaps(basket, boxes[i]);
+                bool got = (hits[i / 64] >> (i % 64) & 1) != 0;
+                maskHits += got;
+                if (expected != got) {
+                    cout << "ERRO: o lote discorda do teste escalar na caixa " << i << endl;
+                    return 1;
+                }
+            }
+            if (batchHits != linearHits || maskHits != linearHits) {
+                cout << "ERRO: o lote achou " << batchHits << " colisões, o teste linear " << linearHits << endl;
+                return 1;
+            }
+            double buildMs = measureMs(repetitions, [&] { grid.build(boxes); });
+            double queryMs = measureMs(repetitions, [&] {
+                grid.query(basket, candidates);
+                size_t hits = 0;
+                for (uint32_t i : candidates) hits += overlaps(basket, boxes[i]);
+                sink += hits;
+            });
+
+            size_t gridHits = 0;
+            double pairsMs = measureMs(repetitions, [&] {
+                grid.findPairs(pairs);
+                gridHits = 0;
+                for (const auto& candidate : pairs) gridHits += overlaps(boxes[candidate.first], boxes[candidate.second]);
+            });
+
+            cout << setw(8) << scaled << setw(12) << linearMs << setw(12) << batchMs << setw(12) << queryMs << setw(12) << buildMs
+                 << setw(13) << pairsMs;
+            if (scaled <= BRUTE_FORCE_LIMIT) {
+                size_t bruteHits = 0;
+                double bruteMs = measureMs(max(1, repetitions / 10), [&] {
+                    bruteHits = 0;
+                    for (size_t i = 0; i < scaled; i++) {
+                        for (size_t j = i + 1; j < scaled; j++) bruteHits += overlaps(boxes[i], boxes[j]);
+                    }
+                });
+                cout << setw(13) << bruteMs;
+                if (bruteHits != gridHits) {
+                    cout << endl << "ERRO: força bruta achou " << bruteHits << " pares, a grade " << gridHits << endl;
+                    return 1;
+                }
+            } else {
+                cout << setw(13) << "-";
+            }
+            cout << setw(10) << gridHits << setw(10) << pairs.size() << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+/*
+ * fruitcatcher_cook
+ *
+ * Ferramenta offline que converte todos os assets referenciados pelo
+ * config.txt num único pacote (.pack):
+ *   - imagens (png/jpg): cadeia de mipmaps comprimida em BC7 (ou RGBA8 com --rgba)
+ *   - efeitos sonoros: PCM f32 pronto para tocar
+ *   - música (chaves MUSIC_*): arquivo original, decodificado em streaming
+ *
+ * Uso: fruitcatcher_cook [--rgba] [config.txt] [saida.pack]
+ * (padrão: ../src/FruitCatcher/config.txt e fruitcatcher.pack, a partir do build)
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+
+using namespace std;
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#define MINIAUDIO_IMPLEMENTATION
+#include <miniaudio.h>
+
+#include "AssetPack.h"
+#include "FileUtils.h"
+#include "ImageOps.h"
+#include "BC7.h"
+
+// Formato do PCM dos efeitos no pacote (o motor converte se o dispositivo for diferente)
+static const ma_uint32 PACK_AUDIO_CHANNELS = 2;
+static const ma_uint32 PACK_AUDIO_SAMPLE_RATE = 48000;
+
+static string toLower(string text)
+{
+    transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return (char)tolower(c); });
+    return text;
+}
+
+static string extensionOf(const string& path)
+{
+    size_t dot = path.rfind('.');
+    return dot == string::npos ? string() : toLower(path.substr(dot + 1));
+}
+
+static string directoryOf(const string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    return slash == string::npos ? string(".") : path.substr(0, slash);
+}
+
+static bool cookTexture(AssetPackWriter& writer, const string& assetPath, const string& filePath, uint64_t sourceHash, bool compress)
+{
+    int width, height, channels;
+    unsigned char* pixels = stbi_load(filePath.c_str(), &width, &height, &channels, 4);
+    if (pixels == nullptr) {
+        cerr << "  ERRO ao decodificar " << filePath << endl;
+        return false;
+    }
+
+    // Mesmo preparo do jogo (TextureCache): alfa pré-multiplicado e linhas de baixo para cima
+    premultiplyAlpha(pixels, (size_t)width * height);
+    flipRowsRGBA(pixels, width, height);
+
+    // Nível 0 seguido de todos os mipmaps até 1x1. Os mipmaps são gerados a
+    // partir do RGBA (não do nível já comprimido)
+    vector<unsigned char> level(pixels, pixels + (size_t)width * height * 4);
+    stbi_image_free(pixels);
+
+    PackEntry entry = {};
+    entry.type = PACK_TEXTURE;
+    entry.format = compress ? PACK_FORMAT_BC7 : PACK_FORMAT_RGBA8;
+    entry.sourceHash = sourceHash;
+    entry.width = width;
+    entry.height = height;
+    entry.mipLevels = 0;
+
+    vector<unsigned char> data;
+    vector<unsigned char> encoded;
+    vector<unsigned char> next;
+    int levelWidth = width, levelHeight = height;
+    while (true) {
+        if (compress) {
+            encodeBC7(level.data(), levelWidth, levelHeight, encoded);
+            data.insert(data.end(), encoded.begin(), encoded.end());
+        } else {
+            data.insert(data.end(), level.begin(), level.end());
+        }
+        entry.mipLevels++;
+        if (levelWidth == 1 && levelHeight == 1) break;
+
+        int nextWidth, nextHeight;
+        downsampleRGBA(level.data(), levelWidth, levelHeight, next, nextWidth, nextHeight);
+        level.swap(next);
+        levelWidth = nextWidth;
+        levelHeight = nextHeight;
+    }
+
+    writer.add(assetPath, entry, data.data(), data.size());
+    cout << "  textura " << normalizeAssetPath(assetPath) << " (" << width << "x" << height
+         << ", " << entry.mipLevels << " níveis, " << (compress ? "BC7" : "RGBA8") << ", "
+         << data.size() / 1024 << " KB)" << endl;
+    return true;
+}
+
+static bool cookSound(AssetPackWriter& writer, const string& assetPath, const string& filePath, uint64_t sourceHash)
+{
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, PACK_AUDIO_CHANNELS, PACK_AUDIO_SAMPLE_RATE);
+    ma_uint64 frameCount = 0;
+    void* frames = NULL;
+    if (ma_decode_file(filePath.c_str(), &decoderConfig, &frameCount, &frames) != MA_SUCCESS) {
+        cerr << "  ERRO ao decodificar " << filePath << endl;
+        return false;
+    }
+
+    PackEntry entry = {};
+    entry.type = PACK_AUDIO_PCM;
+    entry.sourceHash = sourceHash;
+    entry.channels = PACK_AUDIO_CHANNELS;
+    entry.sampleRate = PACK_AUDIO_SAMPLE_RATE;
+    entry.frameCount = frameCount;
+
+    writer.add(assetPath, entry, frames, (size_t)(frameCount * PACK_AUDIO_CHANNELS * sizeof(float)));
+    ma_free(frames, NULL);
+
+    cout << "  som " << normalizeAssetPath(assetPath) << " (" << frameCount << " frames PCM)" << endl;
+    return true;
+}
+
+static bool cookEncoded(AssetPackWriter& writer, const string& assetPath, const vector<unsigned char>& fileData, uint64_t sourceHash)
+{
+    PackEntry entry = {};
+    entry.type = PACK_AUDIO_ENCODED;
+    entry.sourceHash = sourceHash;
+
+    writer.add(assetPath, entry, fileData.data(), fileData.size());
+    cout << "  música " << normalizeAssetPath(assetPath) << " (" << fileData.size() / 1024 << " KB, streaming)" << endl;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    // --rgba: texturas sem compressão (para comparar ou para GPUs sem BC7)
+    bool compress = true;
+    vector<string> arguments;
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        if (argument == "--rgba") compress = false;
+        else arguments.push_back(argument);
+    }
+    string configPath = arguments.size() > 0 ? arguments[0] : "../src/FruitCatcher/config.txt";
+    string outputPath = arguments.size() > 1 ? arguments[1] : "fruitcatcher.pack";
+
+    ifstream config(configPath);
+    if (!config.is_open()) {
+        cerr << "Não foi possível abrir " << configPath << endl;
+        return 1;
+    }
+
+    // Os caminhos do config.txt são relativos à pasta dele
+    string baseDir = directoryOf(configPath);
+
+    cout << "=== FRUITCATCHER COOK ===" << endl;
+    cout << "Config: " << configPath << endl;
+
+    AssetPackWriter writer;
+    int failures = 0;
+    string line;
+    while (getline(config, line)) {
+        line.erase(0, line.find_first_not_of(" \t\r\n"));
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t pos = line.find('=');
+        if (pos == string::npos) continue;
+
+        string key = line.substr(0, pos);
+        string value = line.substr(pos + 1);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+
+        // Spritesheets: path|nAnimations|nFrames
+        string assetPath = value.substr(0, value.find('|'));
+        string extension = extensionOf(assetPath);
+        bool isImage = extension == "png" || extension == "jpg" || extension == "jpeg";
+        bool isAudio = extension == "mp3" || extension == "wav" || extension == "flac" || extension == "ogg";
+        if (!isImage && !isAudio) continue;
+
+        string filePath = baseDir + "/" + assetPath;
+        vector<unsigned char> fileData;
+        if (!readFile(filePath, fileData)) {
+            cerr << "  FALTANDO " << key << ": " << filePath << endl;
+            failures++;
+            continue;
+        }
+        uint64_t sourceHash = hashBytes(fileData.data(), fileData.size());
+
+        bool ok;
+        if (isImage) {
+            ok = cookTexture(writer, assetPath, filePath, sourceHash, compress);
+        } else if (key.compare(0, 6, "MUSIC_") == 0) {
+            ok = cookEncoded(writer, assetPath, fileData, sourceHash);
+        } else {
+            ok = cookSound(writer, assetPath, filePath, sourceHash);
+        }
+        if (!ok) failures++;
+    }
+
+    if (!writer.write(outputPath)) {
+        cerr << "Erro ao gravar " << outputPath << endl;
+        return 1;
+    }
+
+    cout << "Pacote gravado: " << outputPath << " (" << writer.getEntryCount() << " entradas";
+    if (failures > 0) cout << ", " << failures << " falhas";
+    cout << ")" << endl;
+    return failures > 0 ? 2 : 0;
+}